@@ -1,15 +1,1268 @@
 #ifndef JSON_ACCESS_HELPER_HPP_
 #define JSON_ACCESS_HELPER_HPP_
 
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <map>
+#include <string>
 #include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <boost/json.hpp>
 
+// Define as 1 to make the generated functions look up object members through
+// json_access_helper::inline_cache. Every translation unit must use the same value.
+#ifndef JSON_ACCESS_HELPER_INLINE_CACHE
+#define JSON_ACCESS_HELPER_INLINE_CACHE 0
+#endif
+
+// Define as 1 to record json_access_helper::accessor_stats in the generated functions.
+// Every translation unit must use the same value.
+#ifndef JSON_ACCESS_HELPER_ENABLE_STATS
+#define JSON_ACCESS_HELPER_ENABLE_STATS 0
+#endif
+
+#if JSON_ACCESS_HELPER_ENABLE_STATS
+#include <atomic>
+#include <chrono>
+#include <exception>
+#endif
+
+namespace json_access_helper {
+
+// kind of a JSON Pointer reference token
+enum class token_kind : unsigned char {
+    key,           // usable only as an object key
+    index,         // array index (also usable as an object key)
+    past_the_end,  // "-", the element after the last array element
+};
+
+// JSON Pointer reference token whose escapes are already decoded.
+//
+// head and tail are the first and the last 8 bytes of the key in little-endian order (4 bytes
+// if the key is shorter than 8, and all bytes in head if it is shorter than 4), so that a
+// member key is compared with one or two loads. They are set by detail::make_token.
+struct token {
+    std::string_view key = {};
+    std::size_t index = 0;
+    token_kind kind = token_kind::key;
+    std::uint64_t head = 0;
+    std::uint64_t tail = 0;
+};
+
+// base of the tag types defined by the accessor macros.
+// It makes the function templates in this namespace visible to argument-dependent lookup.
+struct accessor_tag {};
+
+template <class T>
+inline constexpr bool is_accessor_tag_v = std::is_base_of_v<accessor_tag, T>;
+
+template <class... Ts>
+inline constexpr bool are_accessor_tags_v = (is_accessor_tag_v<Ts> && ...);
+
+namespace detail {
+
+// true if std::from_chars and std::to_chars support floating point types, e.g. since GCC 11.
+// Otherwise, floating point numbers are converted by Boost.JSON.
+#ifdef __cpp_lib_to_chars
+inline constexpr bool has_floating_charconv = true;
+#else
+inline constexpr bool has_floating_charconv = false;
+#endif
+
+// true if a conversion to T copies everything it needs out of the value. Boost.JSON types
+// (and anything converted by a user's tag_invoke, which may keep one) copy the storage
+// of the value with it.
+template <class T, class = void>
+struct owns_storage
+    : std::bool_constant<std::is_arithmetic_v<T> || std::is_same_v<T, std::nullptr_t>> {};
+
+template <class T, class = void>
+struct owns_elements : owns_storage<typename T::value_type> {};
+
+template <class T>
+struct owns_elements<T, std::void_t<typename T::mapped_type>>
+    : std::bool_constant<owns_storage<typename T::key_type>::value
+                         && owns_storage<typename T::mapped_type>::value> {};
+
+template <class T>
+struct owns_storage<T, std::void_t<typename T::value_type>> : owns_elements<T> {};
+
+template <>
+struct owns_storage<boost::json::string> : std::false_type {};
+
+template <class T>
+inline constexpr bool owns_storage_v = owns_storage<T>::value;
+
+// position of Tag in Tags, or sizeof...(Tags) if it is not there.
+template <class Tag, class... Tags>
+constexpr std::size_t tag_index() {
+    constexpr bool matches[] = {std::is_same_v<Tag, Tags>...};
+    for (std::size_t i = 0; i < sizeof...(Tags); ++i) {
+        if (matches[i]) {
+            return i;
+        }
+    }
+    return sizeof...(Tags);
+}
+
+constexpr bool is_valid_pointer(std::string_view ptr) {
+    if (!ptr.empty() && ptr.front() != '/') {
+        return false;
+    }
+    for (std::size_t i = 0; i < ptr.size(); ++i) {
+        if (ptr[i] == '~') {
+            if (i + 1 == ptr.size() || (ptr[i + 1] != '0' && ptr[i + 1] != '1')) {
+                return false;
+            }
+            ++i;
+        }
+    }
+    return true;
+}
+
+constexpr std::size_t count_tokens(std::string_view ptr) {
+    std::size_t n = 0;
+    for (char c : ptr) {
+        if (c == '/') {
+            ++n;
+        }
+    }
+    return n;
+}
+
+// decodes "~0" and "~1" of all tokens into one buffer.
+template <std::size_t Size>
+constexpr std::array<char, Size> unescape(std::string_view ptr) {
+    std::array<char, Size> chars = {};
+    std::size_t out = 0;
+    for (std::size_t i = 0; i < ptr.size(); ++i) {
+        if (ptr[i] == '/') {
+            continue;
+        }
+        if (ptr[i] == '~') {
+            chars[out++] = ptr[++i] == '0' ? '~' : '/';
+        } else {
+            chars[out++] = ptr[i];
+        }
+    }
+    return chars;
+}
+
+constexpr token classify_token(std::string_view key) {
+    if (key == "-") {
+        return token{key, 0, token_kind::past_the_end};
+    }
+    if (key.empty() || (key.size() > 1 && key.front() == '0')) {
+        return token{key, 0, token_kind::key};
+    }
+    std::size_t index = 0;
+    for (char c : key) {
+        if (c < '0' || c > '9') {
+            return token{key, 0, token_kind::key};
+        }
+        auto digit = static_cast<std::size_t>(c - '0');
+        if (index > (static_cast<std::size_t>(-1) - digit) / 10) {
+            return token{key, 0, token_kind::key};
+        }
+        index = index * 10 + digit;
+    }
+    return token{key, index, token_kind::index};
+}
+
+// packs n bytes of s from pos in little-endian order.
+constexpr std::uint64_t pack_bytes(std::string_view s, std::size_t pos, std::size_t n) {
+    std::uint64_t word = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        word |= static_cast<std::uint64_t>(static_cast<unsigned char>(s[pos + i])) << (8 * i);
+    }
+    return word;
+}
+
+constexpr token make_token(std::string_view key) {
+    auto t = classify_token(key);
+    const auto n = key.size();
+    if (n >= 8) {
+        t.head = pack_bytes(key, 0, 8);
+        t.tail = pack_bytes(key, n - 8, 8);
+    } else if (n >= 4) {
+        t.head = pack_bytes(key, 0, 4);
+        t.tail = pack_bytes(key, n - 4, 4);
+    } else {
+        t.head = pack_bytes(key, 0, n);
+    }
+    return t;
+}
+
+// splits the pointer into tokens whose keys refer to the decoded buffer.
+template <std::size_t N>
+constexpr std::array<token, N> make_tokens(std::string_view ptr, const char* chars) {
+    std::array<token, N> tokens = {};
+    std::size_t i = 0;
+    std::size_t out = 0;
+    for (std::size_t n = 0; n < N; ++n) {
+        ++i;  // skips '/'
+        std::size_t begin = out;
+        while (i < ptr.size() && ptr[i] != '/') {
+            i += ptr[i] == '~' ? 2 : 1;
+            ++out;
+        }
+        tokens[n] = make_token(std::string_view(chars + begin, out - begin));
+    }
+    return tokens;
+}
+
+}  // namespace detail
+
+// JSON Pointer of the tag, tokenized at compile time.
+template <class Tag>
+struct pointer_traits {
+    static constexpr std::string_view string = Tag::json_pointer;
+    static_assert(detail::is_valid_pointer(string), "invalid JSON Pointer");
+
+    static constexpr std::size_t size = detail::count_tokens(string);
+    static constexpr auto chars = detail::unescape<string.size()>(string);
+    static constexpr std::array<token, size> tokens = detail::make_tokens<size>(string, chars.data());
+};
+
+#if JSON_ACCESS_HELPER_ENABLE_STATS
+
+// operation recorded by accessor_stats
+enum class operation : unsigned char {
+    read,       // read, try_read, read_view, try_read_view, read_into and try_read_into
+    write,
+    emplace,
+    reference,
+};
+
+inline constexpr std::size_t operation_count = 4;
+
+// Bucket 0 counts the calls shorter than 1 ns, and bucket i counts the calls in
+// [2^(i-1), 2^i) ns. The last bucket also counts the longer calls.
+inline constexpr std::size_t latency_buckets = 32;
+
+// Statistics of the generated functions of a tag.
+//
+// The counters are relaxed atomics. A tag is registered at the start of the program if its
+// functions are defined, so the tags which are never used are listed with zero counts.
+class accessor_stats {
+public:
+    struct counters {
+        std::uint64_t calls = 0;
+        std::uint64_t misses = 0;               // the pointer was not resolved
+        std::uint64_t conversion_failures = 0;  // the other errors
+        std::array<std::uint64_t, latency_buckets> latency = {};
+    };
+
+    explicit accessor_stats(std::string_view path) noexcept : path_(path) {
+        next_ = head().load(std::memory_order_relaxed);
+        while (!head().compare_exchange_weak(next_, this, std::memory_order_release,
+                                             std::memory_order_relaxed)) {
+        }
+    }
+
+    accessor_stats(const accessor_stats&) = delete;
+    accessor_stats& operator=(const accessor_stats&) = delete;
+
+    std::string_view path() const noexcept {
+        return path_;
+    }
+
+    counters get(operation op) const noexcept {
+        const auto& c = counters_[static_cast<std::size_t>(op)];
+        counters result;
+        result.calls = c.calls.load(std::memory_order_relaxed);
+        result.misses = c.misses.load(std::memory_order_relaxed);
+        result.conversion_failures = c.conversion_failures.load(std::memory_order_relaxed);
+        for (std::size_t i = 0; i < latency_buckets; ++i) {
+            result.latency[i] = c.latency[i].load(std::memory_order_relaxed);
+        }
+        return result;
+    }
+
+    void reset() noexcept {
+        for (auto& c : counters_) {
+            c.calls.store(0, std::memory_order_relaxed);
+            c.misses.store(0, std::memory_order_relaxed);
+            c.conversion_failures.store(0, std::memory_order_relaxed);
+            for (auto& bucket : c.latency) {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Calls f(const accessor_stats&) for each registered tag.
+    template <class F>
+    static void for_each(F&& f) {
+        for (auto p = head().load(std::memory_order_acquire); p; p = p->next_) {
+            f(static_cast<const accessor_stats&>(*p));
+        }
+    }
+
+    // Resets the statistics of all registered tags.
+    static void reset_all() noexcept {
+        for (auto p = head().load(std::memory_order_acquire); p; p = p->next_) {
+            p->reset();
+        }
+    }
+
+    // Returns the statistics of the tag whose pointer is path, or nullptr.
+    static const accessor_stats* find(std::string_view path) noexcept {
+        for (auto p = head().load(std::memory_order_acquire); p; p = p->next_) {
+            if (p->path_ == path) {
+                return p;
+            }
+        }
+        return nullptr;
+    }
+
+    void record(operation op, std::uint64_t nanoseconds, bool missed, bool failed) noexcept {
+        auto& c = counters_[static_cast<std::size_t>(op)];
+        c.calls.fetch_add(1, std::memory_order_relaxed);
+        if (missed) {
+            c.misses.fetch_add(1, std::memory_order_relaxed);
+        } else if (failed) {
+            c.conversion_failures.fetch_add(1, std::memory_order_relaxed);
+        }
+        std::size_t bucket = 0;
+        while (nanoseconds != 0 && bucket + 1 < latency_buckets) {
+            nanoseconds >>= 1;
+            ++bucket;
+        }
+        c.latency[bucket].fetch_add(1, std::memory_order_relaxed);
+    }
+
+private:
+    struct atomic_counters {
+        std::atomic<std::uint64_t> calls{0};
+        std::atomic<std::uint64_t> misses{0};
+        std::atomic<std::uint64_t> conversion_failures{0};
+        std::array<std::atomic<std::uint64_t>, latency_buckets> latency = {};
+    };
+
+    static std::atomic<accessor_stats*>& head() noexcept {
+        static std::atomic<accessor_stats*> head{nullptr};
+        return head;
+    }
+
+    std::string_view path_;
+    accessor_stats* next_ = nullptr;
+    std::array<atomic_counters, operation_count> counters_;
+};
+
+namespace detail {
+
+template <class Tag>
+struct tag_stats {
+    inline static accessor_stats stats{pointer_traits<Tag>::string};
+};
+
+// measures a call of a generated function.
+// The lookup functions set missed when the pointer is not resolved, and the call fails if
+// it exits with an exception or check() sees an error.
+class stats_scope {
+public:
+    stats_scope(accessor_stats& stats, operation op) noexcept
+        : stats_(stats),
+          op_(op),
+          exceptions_(std::uncaught_exceptions()),
+          start_(std::chrono::steady_clock::now()) {
+        missed() = false;
+    }
+
+    ~stats_scope() {
+        auto elapsed = std::chrono::steady_clock::now() - start_;
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+        failed_ = failed_ || std::uncaught_exceptions() > exceptions_;
+        stats_.record(op_, static_cast<std::uint64_t>(ns), missed(), failed_);
+    }
+
+    stats_scope(const stats_scope&) = delete;
+    stats_scope& operator=(const stats_scope&) = delete;
+
+    template <class T>
+    boost::json::result<T> check(boost::json::result<T>&& result) noexcept {
+        failed_ = failed_ || !result;
+        return std::move(result);
+    }
+
+    boost::json::error_code check(const boost::json::error_code& ec) noexcept {
+        failed_ = failed_ || ec;
+        return ec;
+    }
+
+    static bool& missed() noexcept {
+        thread_local bool missed = false;
+        return missed;
+    }
+
+private:
+    accessor_stats& stats_;
+    operation op_;
+    bool failed_ = false;
+    int exceptions_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+}  // namespace detail
+
+// Returns the statistics of the tag.
+template <class Tag, class = std::enable_if_t<is_accessor_tag_v<Tag>>>
+accessor_stats& stats(const Tag&) noexcept {
+    return detail::tag_stats<Tag>::stats;
+}
+
+#define JSON_ACCESS_HELPER_STATS_SCOPE_(TagType, op)                                        \
+    ::json_access_helper::detail::stats_scope json_access_helper_stats_scope_(              \
+        ::json_access_helper::detail::tag_stats<TagType>::stats,                            \
+        ::json_access_helper::operation::op)
+#define JSON_ACCESS_HELPER_STATS_CHECK_(x) json_access_helper_stats_scope_.check(x)
+#define JSON_ACCESS_HELPER_STATS_MISS_() (::json_access_helper::detail::stats_scope::missed() = true)
+
+#else
+
+#define JSON_ACCESS_HELPER_STATS_SCOPE_(TagType, op) static_cast<void>(0)
+#define JSON_ACCESS_HELPER_STATS_CHECK_(x) (x)
+#define JSON_ACCESS_HELPER_STATS_MISS_() static_cast<void>(0)
+
+#endif
+
+namespace detail {
+
+inline bool key_equals(boost::json::string_view lhs, std::string_view rhs) noexcept {
+    return lhs.size() == rhs.size()
+        && (rhs.empty() || std::memcmp(lhs.data(), rhs.data(), rhs.size()) == 0);
+}
+
+#if defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__)
+inline constexpr bool little_endian = __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__;
+#elif defined(_MSC_VER)
+inline constexpr bool little_endian = true;
+#else
+inline constexpr bool little_endian = false;
+#endif
+
+template <class T>
+T load_bytes(const char* p) noexcept {
+    T word;
+    std::memcpy(&word, p, sizeof(word));
+    return word;
+}
+
+// same as key_equals(key, t.key) except that the bytes of the key are compared with the
+// precomputed words of the token. The loads overlap for a key whose size is not a multiple of
+// them, and never read outside the key.
+inline bool key_matches(boost::json::string_view key, const token& t) noexcept {
+    const auto n = t.key.size();
+    if (key.size() != n) {
+        return false;
+    }
+    if constexpr (!little_endian) {
+        return key_equals(key, t.key);
+    } else {
+        const char* p = key.data();
+        if (n >= 8) {
+            return load_bytes<std::uint64_t>(p) == t.head && load_bytes<std::uint64_t>(p + n - 8) == t.tail
+                && (n <= 16 || std::memcmp(p + 8, t.key.data() + 8, n - 16) == 0);
+        }
+        if (n >= 4) {
+            return load_bytes<std::uint32_t>(p) == t.head && load_bytes<std::uint32_t>(p + n - 4) == t.tail;
+        }
+        std::uint64_t word = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            word |= static_cast<std::uint64_t>(static_cast<unsigned char>(p[i])) << (8 * i);
+        }
+        return word == t.head;
+    }
+}
+
+// Objects up to this size are searched linearly. Boost.JSON does not build the hash table of
+// such small objects either, and compares the keys with memcmp one by one.
+inline constexpr std::size_t linear_lookup_size = 18;
+
+// same as object::find except that a small object compares the keys by key_matches.
+template <class Object>
+auto find_member(Object& obj, const token& t) noexcept -> decltype(obj.begin()) {
+    if (obj.size() > linear_lookup_size) {
+        return obj.find(t.key);
+    }
+    const auto last = obj.end();
+    for (auto it = obj.begin(); it != last; ++it) {
+        if (key_matches(it->key(), t)) {
+            return it;
+        }
+    }
+    return last;
+}
+
+// same as boost::json::value::find_pointer except that the pointer is already tokenized.
+template <class Value>
+Value* find(Value& jv, const token* first, const token* last, boost::json::error_code& ec) noexcept {
+    Value* p = &jv;
+    for (auto it = first; it != last; ++it) {
+        if (auto obj = p->if_object()) {
+            auto member = find_member(*obj, *it);
+            if (member == obj->end()) {
+                ec = boost::json::error::not_found;
+                return nullptr;
+            }
+            p = &member->value();
+        } else if (auto arr = p->if_array()) {
+            if (it->kind != token_kind::index) {
+                ec = it->kind == token_kind::past_the_end
+                    ? boost::json::error::past_the_end
+                    : boost::json::error::token_not_number;
+                return nullptr;
+            }
+            p = arr->if_contains(it->index);
+            if (!p) {
+                ec = boost::json::error::not_found;
+                return nullptr;
+            }
+        } else {
+            ec = boost::json::error::value_is_scalar;
+            return nullptr;
+        }
+    }
+    return p;
+}
+
+// the first value created by emplace_path. Removing it undoes the emplacement, since the
+// other values created are inside it.
+struct created_value {
+    boost::json::value* container = nullptr;  // a null value which was made an object or array
+    boost::json::object* object = nullptr;    // an object to which a member was added at the end
+    boost::json::array* array = nullptr;      // an array to which an element was added at the end
+
+    bool empty() const noexcept {
+        return !container && !object && !array;
+    }
+
+    void undo() noexcept {
+        if (container) {
+            *container = nullptr;
+        } else if (object) {
+            object->erase(object->end() - 1);
+        } else if (array) {
+            array->pop_back();
+        }
+    }
+};
+
+// same as boost::json::value::set_at_pointer with the default options except that the
+// pointer is already tokenized and the slot is left as it is. The first value created is
+// recorded in created.
+inline boost::json::value& emplace_path(boost::json::value& jv, const token* first, const token* last,
+                                        created_value& created) {
+    boost::json::value* p = &jv;
+    for (auto it = first; it != last; ++it) {
+        if (p->is_null()) {
+            if (created.empty()) {
+                created.container = p;
+            }
+            if (it->kind == token_kind::key) {
+                p->emplace_object();
+            } else {
+                p->emplace_array();
+            }
+        }
+        if (auto obj = p->if_object()) {
+            const auto size = obj->size();
+            p = &(*obj)[it->key];
+            if (created.empty() && obj->size() != size) {
+                created.object = obj;
+            }
+        } else if (auto arr = p->if_array()) {
+            if (it->kind == token_kind::key) {
+                JSON_ACCESS_HELPER_STATS_MISS_();
+                throw boost::system::system_error(boost::json::error::token_not_number);
+            }
+            auto index = it->kind == token_kind::index ? it->index : arr->size();
+            if (index > arr->size()) {
+                JSON_ACCESS_HELPER_STATS_MISS_();
+                throw boost::system::system_error(boost::json::error::out_of_range);
+            }
+            if (index == arr->size()) {
+                arr->emplace_back(nullptr);
+                if (created.empty()) {
+                    created.array = arr;
+                }
+            }
+            p = &(*arr)[index];
+        } else {
+            JSON_ACCESS_HELPER_STATS_MISS_();
+            throw boost::system::system_error(boost::json::error::value_is_scalar);
+        }
+    }
+    return *p;
+}
+
+// emplaces the slot and calls store(slot). If the pointer or store throws, the values
+// created on the pointer are removed again, so the document is left as it was unless the
+// slot existed before.
+template <class Store>
+boost::json::value& emplace(boost::json::value& jv, const token* first, const token* last, Store&& store) {
+    created_value created;
+    try {
+        auto& ref = emplace_path(jv, first, last, created);
+        store(ref);
+        return ref;
+    } catch (...) {
+        created.undo();
+        throw;
+    }
+}
+
+}  // namespace detail
+
+// Per-thread inline cache of the member positions where the tag was found last time.
+//
+// Documents produced with the same key order are resolved by checking the cached member
+// at each level, and a normal lookup is done only if the key of the member differs.
+template <class Tag>
+class inline_cache {
+public:
+    template <class Value>
+    static Value* find(Value& jv, boost::json::error_code& ec) noexcept {
+        const auto& tokens = pointer_traits<Tag>::tokens;
+        Value* p = &jv;
+        for (std::size_t i = 0; i < tokens.size(); ++i) {
+            auto obj = p->if_object();
+            if (!obj) {
+                p = detail::find(*p, tokens.data() + i, tokens.data() + i + 1, ec);
+                if (!p) {
+                    return nullptr;
+                }
+                continue;
+            }
+            auto& slot = slots_[i];
+            if (slot < obj->size() && detail::key_matches(obj->begin()[slot].key(), tokens[i])) {
+                p = &obj->begin()[slot].value();
+                continue;
+            }
+            auto it = detail::find_member(*obj, tokens[i]);
+            if (it == obj->end()) {
+                ec = boost::json::error::not_found;
+                return nullptr;
+            }
+            slot = static_cast<std::size_t>(it - obj->begin());
+            p = &it->value();
+        }
+        return p;
+    }
+
+private:
+    inline static thread_local std::array<std::size_t, pointer_traits<Tag>::size> slots_ = {};
+};
+
+namespace detail {
+
+template <class Tag, class Value>
+Value* find(Value& jv, boost::json::error_code& ec) noexcept {
+#if JSON_ACCESS_HELPER_INLINE_CACHE
+    auto p = inline_cache<Tag>::find(jv, ec);
+#else
+    const auto& tokens = pointer_traits<Tag>::tokens;
+    auto p = find(jv, tokens.data(), tokens.data() + tokens.size(), ec);
+#endif
+    if (!p) {
+        JSON_ACCESS_HELPER_STATS_MISS_();
+    }
+    return p;
+}
+
+template <class Tag, class Value>
+Value& at(Value& jv) {
+    boost::json::error_code ec;
+    auto ref = find<Tag>(jv, ec);
+    if (!ref) {
+        throw boost::system::system_error(ec);
+    }
+    return *ref;
+}
+
+template <class Tag, class Store>
+boost::json::value& emplace(boost::json::value& jv, Store&& store) {
+    const auto& tokens = pointer_traits<Tag>::tokens;
+    return emplace(jv, tokens.data(), tokens.data() + tokens.size(), std::forward<Store>(store));
+}
+
+struct token_span {
+    const token* data;
+    std::size_t size;
+};
+
+constexpr int token_rank(token_kind kind) {
+    return kind == token_kind::index ? 0 : kind == token_kind::past_the_end ? 1 : 2;
+}
+
+// array indices are compared as numbers and precede "-", so that the elements are visited
+// in index order. Keys follow them in lexicographical order. The order of the kinds is
+// compared first, which keeps the order total when the tokens under one parent mix them.
+constexpr bool token_span_less(const token_span& lhs, const token_span& rhs) {
+    for (std::size_t i = 0; i < lhs.size && i < rhs.size; ++i) {
+        const auto& l = lhs.data[i];
+        const auto& r = rhs.data[i];
+        if (l.kind != r.kind) {
+            return token_rank(l.kind) < token_rank(r.kind);
+        }
+        if (l.kind == token_kind::index) {
+            if (l.index != r.index) {
+                return l.index < r.index;
+            }
+        } else if (l.key != r.key) {
+            return l.key < r.key;
+        }
+    }
+    return lhs.size < rhs.size;
+}
+
+constexpr std::size_t common_prefix(const token_span& lhs, const token_span& rhs) {
+    std::size_t n = 0;
+    while (n < lhs.size && n < rhs.size && lhs.data[n].key == rhs.data[n].key) {
+        ++n;
+    }
+    return n;
+}
+
+// order to resolve several pointers in one traversal.
+// Pointers are visited in lexicographical order of their tokens, so each pointer reuses
+// the nodes resolved for the tokens it shares with the previous one.
+template <std::size_t N>
+struct traversal_plan {
+    std::array<std::size_t, N> order = {};
+    std::array<std::size_t, N> shared = {};
+    std::size_t max_depth = 0;
+};
+
+template <std::size_t N>
+constexpr traversal_plan<N> make_traversal_plan(const std::array<token_span, N>& spans) {
+    traversal_plan<N> plan;
+    for (std::size_t i = 0; i < N; ++i) {
+        std::size_t j = i;
+        while (j > 0 && token_span_less(spans[i], spans[plan.order[j - 1]])) {
+            plan.order[j] = plan.order[j - 1];
+            --j;
+        }
+        plan.order[j] = i;
+        if (spans[i].size > plan.max_depth) {
+            plan.max_depth = spans[i].size;
+        }
+    }
+    for (std::size_t i = 1; i < N; ++i) {
+        plan.shared[i] = common_prefix(spans[plan.order[i - 1]], spans[plan.order[i]]);
+    }
+    return plan;
+}
+
+template <class... Tags>
+struct multi_pointer_traits {
+    static constexpr std::size_t size = sizeof...(Tags);
+    static constexpr std::array<token_span, size> spans = {{
+        token_span{pointer_traits<Tags>::tokens.data(), pointer_traits<Tags>::size}...
+    }};
+    static constexpr traversal_plan<size> plan = make_traversal_plan(spans);
+};
+
+// finds the values of all tags, resolving each shared parent once.
+template <class... Tags, class Value>
+std::array<Value*, sizeof...(Tags)> find_all(
+    Value& jv, std::array<boost::json::error_code, sizeof...(Tags)>& ecs) noexcept {
+    using traits = multi_pointer_traits<Tags...>;
+    std::array<Value*, sizeof...(Tags)> refs = {};
+    std::array<Value*, traits::plan.max_depth + 1> nodes = {};
+    nodes[0] = &jv;
+    std::size_t resolved = 0;  // number of tokens resolved for the previous tag
+    for (std::size_t i = 0; i < traits::size; ++i) {
+        auto tag = traits::plan.order[i];
+        const auto& span = traits::spans[tag];
+        auto depth = traits::plan.shared[i] < resolved ? traits::plan.shared[i] : resolved;
+        while (depth < span.size) {
+            auto next = find(*nodes[depth], span.data + depth, span.data + depth + 1, ecs[tag]);
+            if (!next) {
+                break;
+            }
+            nodes[++depth] = next;
+        }
+        resolved = depth;
+        refs[tag] = depth == span.size ? nodes[depth] : nullptr;
+    }
+    return refs;
+}
+
+template <class... Tags, std::size_t... Is>
+std::tuple<typename Tags::value_type...> read_all(const boost::json::value& jv, std::index_sequence<Is...>) {
+    std::array<boost::json::error_code, sizeof...(Tags)> ecs;
+    auto refs = find_all<Tags...>(jv, ecs);
+    for (std::size_t i = 0; i < refs.size(); ++i) {
+        if (!refs[i]) {
+            throw boost::system::system_error(ecs[i]);
+        }
+    }
+    return {boost::json::value_to<typename Tags::value_type>(*refs[Is])...};
+}
+
+template <class T>
+boost::json::result<T> try_value_to(const boost::json::value* ref, const boost::json::error_code& ec) {
+    if (!ref) {
+        return ec;
+    }
+    return boost::json::try_value_to<T>(*ref);
+}
+
+template <class... Tags, std::size_t... Is>
+std::tuple<boost::json::result<typename Tags::value_type>...> try_read_all(
+    const boost::json::value& jv, std::index_sequence<Is...>) {
+    std::array<boost::json::error_code, sizeof...(Tags)> ecs;
+    auto refs = find_all<Tags...>(jv, ecs);
+    return {try_value_to<typename Tags::value_type>(refs[Is], ecs[Is])...};
+}
+
+}  // namespace detail
+
+// Reads the values of several tags in one traversal.
+// Throws exception if any error occurs.
+template <class Tag1, class Tag2, class... Tags,
+          class = std::enable_if_t<are_accessor_tags_v<Tag1, Tag2, Tags...>>>
+std::tuple<typename Tag1::value_type, typename Tag2::value_type, typename Tags::value_type...>
+read(const boost::json::value& jv, const Tag1&, const Tag2&, const Tags&...) {
+    return detail::read_all<Tag1, Tag2, Tags...>(jv, std::index_sequence_for<Tag1, Tag2, Tags...>());
+}
+
+// Tries to read the values of several tags in one traversal.
+// Each element of the tuple is the result of the corresponding tag.
+template <class Tag1, class Tag2, class... Tags,
+          class = std::enable_if_t<are_accessor_tags_v<Tag1, Tag2, Tags...>>>
+std::tuple<boost::json::result<typename Tag1::value_type>,
+           boost::json::result<typename Tag2::value_type>,
+           boost::json::result<typename Tags::value_type>...>
+try_read(const boost::json::value& jv, const Tag1&, const Tag2&, const Tags&...) {
+    return detail::try_read_all<Tag1, Tag2, Tags...>(jv, std::index_sequence_for<Tag1, Tag2, Tags...>());
+}
+
+// Converts the value referred to by a tag to the type returned by read_view.
+// The types which refer to the value are specialized below, and the others are converted
+// by value_to.
+template <class T>
+struct view_traits {
+    using type = T;
+
+    static type view(const boost::json::value& jv) {
+        return boost::json::value_to<T>(jv);
+    }
+
+    static boost::json::result<type> try_view(const boost::json::value& jv) {
+        return boost::json::try_value_to<T>(jv);
+    }
+};
+
+template <class T>
+using view_t = typename view_traits<T>::type;
+
+// Read-only view of boost::json::array whose elements are converted to view_t<T> on
+// dereference. The view refers to the array, so it must not outlive the array.
+template <class T>
+class array_view {
+public:
+    using value_type = view_t<T>;
+    using size_type = std::size_t;
+
+    class iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = view_t<T>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = value_type;
+
+        iterator() = default;
+
+        explicit iterator(const boost::json::value* it) : it_(it) {}
+
+        // Throws exception if the element cannot be converted.
+        value_type operator*() const {
+            return view_traits<T>::view(*it_);
+        }
+
+        iterator& operator++() {
+            ++it_;
+            return *this;
+        }
+
+        iterator operator++(int) {
+            auto it = *this;
+            ++it_;
+            return it;
+        }
+
+        friend bool operator==(const iterator& lhs, const iterator& rhs) {
+            return lhs.it_ == rhs.it_;
+        }
+
+        friend bool operator!=(const iterator& lhs, const iterator& rhs) {
+            return lhs.it_ != rhs.it_;
+        }
+
+    private:
+        const boost::json::value* it_ = nullptr;
+    };
+
+    explicit array_view(const boost::json::array& array) : array_(&array) {}
+
+    size_type size() const noexcept {
+        return array_->size();
+    }
+
+    bool empty() const noexcept {
+        return array_->empty();
+    }
+
+    iterator begin() const noexcept {
+        return iterator(array_->data());
+    }
+
+    iterator end() const noexcept {
+        return iterator(array_->data() + array_->size());
+    }
+
+    value_type operator[](size_type i) const {
+        return view_traits<T>::view((*array_)[i]);
+    }
+
+    // Throws exception if i is out of range.
+    value_type at(size_type i) const {
+        return view_traits<T>::view(array_->at(i));
+    }
+
+    const boost::json::array& array() const noexcept {
+        return *array_;
+    }
+
+private:
+    const boost::json::array* array_;
+};
+
+template <class Traits, class Allocator>
+struct view_traits<std::basic_string<char, Traits, Allocator>> {
+    using type = std::string_view;
+
+    static type view(const boost::json::value& jv) {
+        const auto& str = jv.as_string();
+        return type(str.data(), str.size());
+    }
+
+    static boost::json::result<type> try_view(const boost::json::value& jv) {
+        if (auto str = jv.if_string()) {
+            return type(str->data(), str->size());
+        }
+        return boost::json::make_error_code(boost::json::error::not_string);
+    }
+};
+
+template <class T, class Allocator>
+struct view_traits<std::vector<T, Allocator>> {
+    using type = array_view<T>;
+
+    static type view(const boost::json::value& jv) {
+        return type(jv.as_array());
+    }
+
+    static boost::json::result<type> try_view(const boost::json::value& jv) {
+        if (auto array = jv.if_array()) {
+            return type(*array);
+        }
+        return boost::json::make_error_code(boost::json::error::not_array);
+    }
+};
+
+namespace detail {
+
+// loads the value into out reusing the storage of out, e.g. the capacity of strings and
+// vectors and the nodes of maps. The content of out is unspecified if ec is set.
+template <class T>
+void load(const boost::json::value& jv, T& out, boost::json::error_code& ec);
+
+template <class Traits, class Allocator>
+void load(const boost::json::value& jv, std::basic_string<char, Traits, Allocator>& out,
+          boost::json::error_code& ec);
+
+template <class T, class Allocator>
+void load(const boost::json::value& jv, std::vector<T, Allocator>& out, boost::json::error_code& ec);
+
+template <class Allocator>
+void load(const boost::json::value& jv, std::vector<bool, Allocator>& out, boost::json::error_code& ec);
+
+template <class Traits, class KeyAllocator, class T, class Compare, class Allocator>
+void load(const boost::json::value& jv,
+          std::map<std::basic_string<char, Traits, KeyAllocator>, T, Compare, Allocator>& out,
+          boost::json::error_code& ec);
+
+template <class Traits, class KeyAllocator, class T, class Hash, class KeyEqual, class Allocator>
+void load(const boost::json::value& jv,
+          std::unordered_map<std::basic_string<char, Traits, KeyAllocator>, T, Hash, KeyEqual,
+                             Allocator>& out,
+          boost::json::error_code& ec);
+
+template <class T>
+void load_converted(const boost::json::value& jv, T& out, boost::json::error_code& ec) {
+    auto result = boost::json::try_value_to<T>(jv);
+    if (!result) {
+        ec = result.error();
+        return;
+    }
+    out = std::move(*result);
+}
+
+template <class Map>
+void load_map(const boost::json::value& jv, Map& out, boost::json::error_code& ec) {
+    auto object = jv.if_object();
+    if (!object) {
+        ec = boost::json::error::not_object;
+        return;
+    }
+    // reused so that looking up the existing entries does not allocate
+    static thread_local typename Map::key_type key;
+    for (const auto& member : *object) {
+        key.assign(member.key().data(), member.key().size());
+        auto it = out.find(key);
+        if (it == out.end()) {
+            it = out.emplace(key, typename Map::mapped_type()).first;
+        }
+        load(member.value(), it->second, ec);
+        if (ec) {
+            return;
+        }
+    }
+    // every key of the object is in out, so out has stale entries only if it is larger
+    if (out.size() == object->size()) {
+        return;
+    }
+    for (auto it = out.begin(); it != out.end();) {
+        if (object->find(boost::json::string_view(it->first.data(), it->first.size())) == object->end()) {
+            it = out.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+template <class T>
+void load(const boost::json::value& jv, T& out, boost::json::error_code& ec) {
+    load_converted(jv, out, ec);
+}
+
+template <class Traits, class Allocator>
+void load(const boost::json::value& jv, std::basic_string<char, Traits, Allocator>& out,
+          boost::json::error_code& ec) {
+    auto str = jv.if_string();
+    if (!str) {
+        ec = boost::json::error::not_string;
+        return;
+    }
+    out.assign(str->data(), str->size());
+}
+
+template <class T, class Allocator>
+void load(const boost::json::value& jv, std::vector<T, Allocator>& out, boost::json::error_code& ec) {
+    if constexpr (!std::is_default_constructible_v<T>) {
+        load_converted(jv, out, ec);
+    } else {
+        auto array = jv.if_array();
+        if (!array) {
+            ec = boost::json::error::not_array;
+            return;
+        }
+        // the remaining elements keep their storage
+        out.resize(array->size());
+        for (std::size_t i = 0; i < array->size(); ++i) {
+            load((*array)[i], out[i], ec);
+            if (ec) {
+                return;
+            }
+        }
+    }
+}
+
+template <class Allocator>
+void load(const boost::json::value& jv, std::vector<bool, Allocator>& out, boost::json::error_code& ec) {
+    load_converted(jv, out, ec);
+}
+
+template <class Traits, class KeyAllocator, class T, class Compare, class Allocator>
+void load(const boost::json::value& jv,
+          std::map<std::basic_string<char, Traits, KeyAllocator>, T, Compare, Allocator>& out,
+          boost::json::error_code& ec) {
+    load_map(jv, out, ec);
+}
+
+template <class Traits, class KeyAllocator, class T, class Hash, class KeyEqual, class Allocator>
+void load(const boost::json::value& jv,
+          std::unordered_map<std::basic_string<char, Traits, KeyAllocator>, T, Hash, KeyEqual,
+                             Allocator>& out,
+          boost::json::error_code& ec) {
+    load_map(jv, out, ec);
+}
+
+
+// stores the value into dst reusing the storage of dst, e.g. the buffers of strings and
+// arrays. New values are allocated with dst.storage().
+template <class T>
+void store(boost::json::value& dst, const T& value);
+
+template <class Traits, class Allocator>
+void store(boost::json::value& dst, const std::basic_string<char, Traits, Allocator>& value);
+
+template <class T, class Allocator>
+void store(boost::json::value& dst, const std::vector<T, Allocator>& value);
+
+template <class Allocator>
+void store(boost::json::value& dst, const std::vector<bool, Allocator>& value);
+
+template <class Traits, class KeyAllocator, class T, class Compare, class Allocator>
+void store(boost::json::value& dst,
+           const std::map<std::basic_string<char, Traits, KeyAllocator>, T, Compare, Allocator>& value);
+
+template <class Traits, class KeyAllocator, class T, class Hash, class KeyEqual, class Allocator>
+void store(boost::json::value& dst,
+           const std::unordered_map<std::basic_string<char, Traits, KeyAllocator>, T, Hash, KeyEqual,
+                                    Allocator>& value);
+
+template <class T>
+void store_converted(boost::json::value& dst, const T& value) {
+    dst = boost::json::value_from(value, dst.storage());
+}
+
+template <class Map>
+void store_map(boost::json::value& dst, const Map& value) {
+    auto object = dst.if_object();
+    if (!object) {
+        object = &dst.emplace_object();
+        object->reserve(value.size());
+    }
+    for (const auto& [key, mapped] : value) {
+        store((*object)[boost::json::string_view(key.data(), key.size())], mapped);
+    }
+    // every key of the map is in the object, so the object has stale members only if it is larger
+    if (object->size() == value.size()) {
+        return;
+    }
+    for (auto it = object->begin(); it != object->end();) {
+        if (value.find(typename Map::key_type(it->key().data(), it->key().size())) == value.end()) {
+            it = object->erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+template <class T>
+void store(boost::json::value& dst, const T& value) {
+    store_converted(dst, value);
+}
+
+template <class Traits, class Allocator>
+void store(boost::json::value& dst, const std::basic_string<char, Traits, Allocator>& value) {
+    auto str = dst.if_string();
+    if (!str) {
+        str = &dst.emplace_string();
+    }
+    str->assign(boost::json::string_view(value.data(), value.size()));
+}
+
+template <class T, class Allocator>
+void store(boost::json::value& dst, const std::vector<T, Allocator>& value) {
+    auto array = dst.if_array();
+    if (!array) {
+        array = &dst.emplace_array();
+    }
+    // the remaining elements keep their storage
+    array->resize(value.size());
+    for (std::size_t i = 0; i < value.size(); ++i) {
+        store((*array)[i], value[i]);
+    }
+}
+
+template <class Allocator>
+void store(boost::json::value& dst, const std::vector<bool, Allocator>& value) {
+    store_converted(dst, value);
+}
+
+template <class Traits, class KeyAllocator, class T, class Compare, class Allocator>
+void store(boost::json::value& dst,
+           const std::map<std::basic_string<char, Traits, KeyAllocator>, T, Compare, Allocator>& value) {
+    store_map(dst, value);
+}
+
+template <class Traits, class KeyAllocator, class T, class Hash, class KeyEqual, class Allocator>
+void store(boost::json::value& dst,
+           const std::unordered_map<std::basic_string<char, Traits, KeyAllocator>, T, Hash, KeyEqual,
+                                    Allocator>& value) {
+    store_map(dst, value);
+}
+
+
+// true if store() writes the value into the storage of dst instead of converting it.
+template <class T>
+struct stores_in_place : std::false_type {};
+
+template <class Traits, class Allocator>
+struct stores_in_place<std::basic_string<char, Traits, Allocator>> : std::true_type {};
+
+template <class T, class Allocator>
+struct stores_in_place<std::vector<T, Allocator>> : std::true_type {};
+
+template <class Allocator>
+struct stores_in_place<std::vector<bool, Allocator>> : std::false_type {};
+
+template <class Traits, class KeyAllocator, class T, class Compare, class Allocator>
+struct stores_in_place<std::map<std::basic_string<char, Traits, KeyAllocator>, T, Compare, Allocator>>
+    : std::true_type {};
+
+template <class Traits, class KeyAllocator, class T, class Hash, class KeyEqual, class Allocator>
+struct stores_in_place<std::unordered_map<std::basic_string<char, Traits, KeyAllocator>, T, Hash, KeyEqual,
+                                          Allocator>> : std::true_type {};
+
+// same as store except that a value which is converted is moved into value_from.
+template <class T>
+void store_moved(boost::json::value& dst, T&& value) {
+    static_assert(!std::is_lvalue_reference_v<T>, "store_moved needs an rvalue");
+    if constexpr (stores_in_place<T>::value) {
+        store(dst, value);
+    } else {
+        dst = boost::json::value_from(std::move(value), dst.storage());
+    }
+}
+
+}  // namespace detail
+
+}  // namespace json_access_helper
+
+#define JSON_ACCESS_HELPER_DEFINE_TAG_(Tag, Type, Key)                                      \
+    struct Tag##T : ::json_access_helper::accessor_tag {                                    \
+        using value_type = Type;                                                            \
+        static constexpr std::string_view json_pointer = Key;                               \
+    };
+
 #define DECLARE_JSON_ACCESSOR(Tag, Type, Key)                                               \
-    struct Tag##T {};                                                                       \
+    JSON_ACCESS_HELPER_DEFINE_TAG_(Tag, Type, Key)                                          \
     inline constexpr Tag##T Tag = {};                                                       \
     Type read(const boost::json::value& jv, const Tag##T&);                                 \
     boost::json::result<Type> try_read(const boost::json::value& jv, const Tag##T&);        \
+    ::json_access_helper::view_t<Type>                                                      \
+    read_view(const boost::json::value& jv, const Tag##T&);                                 \
+    boost::json::result<::json_access_helper::view_t<Type>>                                 \
+    try_read_view(const boost::json::value& jv, const Tag##T&);                             \
+    void read_into(const boost::json::value& jv, const Tag##T&, Type& out);                 \
+    boost::json::error_code                                                                 \
+    try_read_into(const boost::json::value& jv, const Tag##T&, Type& out);                  \
     bool write(boost::json::value& jv, const Tag##T&, const Type& value);                   \
     bool write(boost::json::value& jv, const Tag##T&, Type&& value);                        \
     bool write(boost::json::value& jv, const Tag##T&, nullptr_t value);                     \
@@ -21,40 +1274,80 @@
     std::string_view path(const Tag##T&);
 
 #define DEFINE_JSON_ACCESSOR(Tag, Type, Key)                                                \
-    struct Tag##T {};                                                                       \
+    JSON_ACCESS_HELPER_DEFINE_TAG_(Tag, Type, Key)                                          \
     constexpr auto Tag##Path = boost::json::string_view(Key);                               \
     Type read(const boost::json::value& jv, const Tag##T&) {                                \
-        return boost::json::value_to<Type>(jv.at_pointer(Tag##Path));                       \
+        JSON_ACCESS_HELPER_STATS_SCOPE_(Tag##T, read);                                      \
+        return boost::json::value_to<Type>(::json_access_helper::detail::at<Tag##T>(jv));   \
     }                                                                                       \
     boost::json::result<Type> try_read(const boost::json::value& jv, const Tag##T&) {       \
+        JSON_ACCESS_HELPER_STATS_SCOPE_(Tag##T, read);                                      \
         boost::json::error_code ec;                                                         \
-        auto ref = jv.find_pointer(Tag##Path, ec);                                          \
+        auto ref = ::json_access_helper::detail::find<Tag##T>(jv, ec);                      \
         if (!ref) {                                                                         \
             return ec;                                                                      \
         }                                                                                   \
-        return boost::json::try_value_to<Type>(*ref);                                       \
+        return JSON_ACCESS_HELPER_STATS_CHECK_(boost::json::try_value_to<Type>(*ref));      \
+    }                                                                                       \
+    ::json_access_helper::view_t<Type>                                                      \
+    read_view(const boost::json::value& jv, const Tag##T&) {                                \
+        JSON_ACCESS_HELPER_STATS_SCOPE_(Tag##T, read);                                      \
+        return ::json_access_helper::view_traits<Type>::view(                               \
+            ::json_access_helper::detail::at<Tag##T>(jv));                                  \
+    }                                                                                       \
+    boost::json::result<::json_access_helper::view_t<Type>>                                 \
+    try_read_view(const boost::json::value& jv, const Tag##T&) {                            \
+        JSON_ACCESS_HELPER_STATS_SCOPE_(Tag##T, read);                                      \
+        boost::json::error_code ec;                                                         \
+        auto ref = ::json_access_helper::detail::find<Tag##T>(jv, ec);                      \
+        if (!ref) {                                                                         \
+            return ec;                                                                      \
+        }                                                                                   \
+        return JSON_ACCESS_HELPER_STATS_CHECK_(                                             \
+            ::json_access_helper::view_traits<Type>::try_view(*ref));                       \
+    }                                                                                       \
+    void read_into(const boost::json::value& jv, const Tag##T&, Type& out) {                \
+        JSON_ACCESS_HELPER_STATS_SCOPE_(Tag##T, read);                                      \
+        boost::json::error_code ec;                                                         \
+        const auto& ref = ::json_access_helper::detail::at<Tag##T>(jv);                     \
+        ::json_access_helper::detail::load(ref, out, ec);                                   \
+        if (ec) {                                                                           \
+            throw boost::system::system_error(ec);                                          \
+        }                                                                                   \
+    }                                                                                       \
+    boost::json::error_code                                                                 \
+    try_read_into(const boost::json::value& jv, const Tag##T&, Type& out) {                 \
+        JSON_ACCESS_HELPER_STATS_SCOPE_(Tag##T, read);                                      \
+        boost::json::error_code ec;                                                         \
+        if (auto ref = ::json_access_helper::detail::find<Tag##T>(jv, ec)) {                \
+            ::json_access_helper::detail::load(*ref, out, ec);                              \
+        }                                                                                   \
+        return JSON_ACCESS_HELPER_STATS_CHECK_(ec);                                         \
     }                                                                                       \
     bool write(boost::json::value& jv, const Tag##T&, const Type& value) {                  \
+        JSON_ACCESS_HELPER_STATS_SCOPE_(Tag##T, write);                                     \
         boost::json::error_code ec;                                                         \
-        auto ref = jv.find_pointer(Tag##Path, ec);                                          \
+        auto ref = ::json_access_helper::detail::find<Tag##T>(jv, ec);                      \
         if (!ref) {                                                                         \
             return false;                                                                   \
         }                                                                                   \
-        *ref = boost::json::value_from(value);                                              \
+        ::json_access_helper::detail::store(*ref, value);                                   \
         return true;                                                                        \
     }                                                                                       \
     bool write(boost::json::value& jv, const Tag##T&, Type&& value) {                       \
+        JSON_ACCESS_HELPER_STATS_SCOPE_(Tag##T, write);                                     \
         boost::json::error_code ec;                                                         \
-        auto ref = jv.find_pointer(Tag##Path, ec);                                          \
+        auto ref = ::json_access_helper::detail::find<Tag##T>(jv, ec);                      \
         if (!ref) {                                                                         \
             return false;                                                                   \
         }                                                                                   \
-        *ref = boost::json::value_from(std::move(value));                                   \
+        ::json_access_helper::detail::store_moved(*ref, std::move(value));                  \
         return true;                                                                        \
     }                                                                                       \
     bool write(boost::json::value& jv, const Tag##T&, nullptr_t) {                          \
+        JSON_ACCESS_HELPER_STATS_SCOPE_(Tag##T, write);                                     \
         boost::json::error_code ec;                                                         \
-        auto ref = jv.find_pointer(Tag##Path, ec);                                          \
+        auto ref = ::json_access_helper::detail::find<Tag##T>(jv, ec);                      \
         if (!ref) {                                                                         \
             return false;                                                                   \
         }                                                                                   \
@@ -62,21 +1355,35 @@
         return true;                                                                        \
     }                                                                                       \
     boost::json::value& emplace(boost::json::value& jv, const Tag##T&, const Type& value) { \
-        return jv.set_at_pointer(Tag##Path, boost::json::value_from(value));                \
+        JSON_ACCESS_HELPER_STATS_SCOPE_(Tag##T, emplace);                                   \
+        auto store = [&](boost::json::value& slot) {                                        \
+            ::json_access_helper::detail::store(slot, value);                               \
+        };                                                                                  \
+        return ::json_access_helper::detail::emplace<Tag##T>(jv, store);                    \
     }                                                                                       \
     boost::json::value& emplace(boost::json::value& jv, const Tag##T&, Type&& value) {      \
-        return jv.set_at_pointer(Tag##Path, boost::json::value_from(std::move(value)));     \
+        JSON_ACCESS_HELPER_STATS_SCOPE_(Tag##T, emplace);                                   \
+        auto store = [&](boost::json::value& slot) {                                        \
+            ::json_access_helper::detail::store_moved(slot, std::move(value));              \
+        };                                                                                  \
+        return ::json_access_helper::detail::emplace<Tag##T>(jv, store);                    \
     }                                                                                       \
     boost::json::value& emplace(boost::json::value& jv, const Tag##T&, nullptr_t) {         \
-        return jv.set_at_pointer(Tag##Path, boost::json::value(nullptr));                   \
+        JSON_ACCESS_HELPER_STATS_SCOPE_(Tag##T, emplace);                                   \
+        auto store = [](boost::json::value& slot) {                                         \
+            slot = nullptr;                                                                 \
+        };                                                                                  \
+        return ::json_access_helper::detail::emplace<Tag##T>(jv, store);                    \
     }                                                                                       \
     boost::json::value* reference(boost::json::value& jv, const Tag##T&) {                  \
+        JSON_ACCESS_HELPER_STATS_SCOPE_(Tag##T, reference);                                 \
         boost::json::error_code ec;                                                         \
-        return jv.find_pointer(Tag##Path, ec);                                              \
+        return ::json_access_helper::detail::find<Tag##T>(jv, ec);                          \
     }                                                                                       \
     const boost::json::value* reference(const boost::json::value& jv, const Tag##T&) {      \
+        JSON_ACCESS_HELPER_STATS_SCOPE_(Tag##T, reference);                                 \
         boost::json::error_code ec;                                                         \
-        return jv.find_pointer(Tag##Path, ec);                                              \
+        return ::json_access_helper::detail::find<Tag##T>(jv, ec);                          \
     }                                                                                       \
     std::string_view path(const Tag##T&) {                                                  \
         return Tag##Path;                                                                   \
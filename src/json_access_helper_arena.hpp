@@ -0,0 +1,203 @@
+#ifndef JSON_ACCESS_HELPER_ARENA_HPP_
+#define JSON_ACCESS_HELPER_ARENA_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <boost/json.hpp>
+
+#include "json_access_helper.hpp"
+
+namespace json_access_helper {
+
+namespace detail {
+
+// monotonic_resource which counts the requested bytes.
+class arena_resource : public boost::json::memory_resource {
+public:
+    arena_resource(unsigned char* buffer, std::size_t size) : resource_(buffer, size) {}
+
+    std::size_t used() const noexcept {
+        return used_;
+    }
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t align) override {
+        used_ += bytes;
+        return resource_.allocate(bytes, align);
+    }
+
+    void do_deallocate(void*, std::size_t, std::size_t) override {}
+
+    bool do_is_equal(const boost::json::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    boost::json::monotonic_resource resource_;
+    std::size_t used_ = 0;
+};
+
+// buffer and resource of a document, which are recycled by document_pool.
+struct arena_slot {
+    std::unique_ptr<unsigned char[]> buffer;
+    std::size_t size = 0;
+    std::optional<arena_resource> resource;
+    std::optional<boost::json::value> value;
+};
+
+}  // namespace detail
+
+}  // namespace json_access_helper
+
+namespace boost {
+namespace json {
+
+// the values on arena_resource are released with the resource without visiting them.
+template <>
+struct is_deallocate_trivial<json_access_helper::detail::arena_resource> {
+    static constexpr bool value = true;
+};
+
+}  // namespace json
+}  // namespace boost
+
+namespace json_access_helper {
+
+// Pool of request-scoped documents.
+//
+// Each document is boost::json::value whose storage is a monotonic_resource on a buffer of
+// the pool. Releasing a document frees the whole tree at once and returns the buffer to the
+// pool for the next document. The size of new buffers follows the bytes used by the
+// released documents, so that a document usually fits in its first buffer.
+// The functions are thread safe. The pool must outlive its documents.
+class document_pool {
+public:
+    // Document borrowed from the pool. It is returned to the pool on destruction.
+    class document {
+    public:
+        document(document&& other) noexcept
+            : pool_(std::exchange(other.pool_, nullptr)), slot_(std::move(other.slot_)) {}
+
+        document& operator=(document&& other) noexcept {
+            if (this != &other) {
+                reset();
+                pool_ = std::exchange(other.pool_, nullptr);
+                slot_ = std::move(other.slot_);
+            }
+            return *this;
+        }
+
+        ~document() {
+            reset();
+        }
+
+        boost::json::value& value() noexcept {
+            return *slot_->value;
+        }
+
+        const boost::json::value& value() const noexcept {
+            return *slot_->value;
+        }
+
+        // Returns the bytes allocated by the document so far.
+        std::size_t used() const noexcept {
+            return slot_->resource->used();
+        }
+
+        // Returns the size of the buffer of the document.
+        std::size_t capacity() const noexcept {
+            return slot_->size;
+        }
+
+        // Returns the document to the pool. The value must not be used after this call.
+        void reset() {
+            if (pool_) {
+                std::exchange(pool_, nullptr)->release(std::move(slot_));
+            }
+        }
+
+    private:
+        friend class document_pool;
+
+        document(document_pool* pool, std::unique_ptr<detail::arena_slot> slot) noexcept
+            : pool_(pool), slot_(std::move(slot)) {}
+
+        document_pool* pool_;
+        std::unique_ptr<detail::arena_slot> slot_;
+    };
+
+    // min_block_size is the lower bound of the buffer size, and max_free_buffers is the
+    // number of buffers kept for the next documents.
+    explicit document_pool(std::size_t min_block_size = 4096, std::size_t max_free_buffers = 16)
+        : min_block_size_(min_block_size),
+          max_free_buffers_(max_free_buffers),
+          block_size_(min_block_size) {
+        free_.reserve(max_free_buffers);
+    }
+
+    document_pool(const document_pool&) = delete;
+    document_pool& operator=(const document_pool&) = delete;
+
+    // Returns an empty (null) document.
+    document acquire() {
+        std::unique_ptr<detail::arena_slot> slot;
+        std::size_t size;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            size = block_size_;
+            if (!free_.empty()) {
+                slot = std::move(free_.back());
+                free_.pop_back();
+            }
+        }
+        if (!slot) {
+            slot = std::make_unique<detail::arena_slot>();
+        }
+        // a buffer smaller than the current size is replaced, and so is one more than twice as
+        // large, so that the buffers shrink after a large document
+        if (slot->size < size || slot->size / 2 > size) {
+            slot->buffer.reset(new unsigned char[size]);
+            slot->size = size;
+        }
+        slot->resource.emplace(slot->buffer.get(), slot->size);
+        slot->value.emplace(boost::json::storage_ptr(&*slot->resource));
+        return document(this, std::move(slot));
+    }
+
+    // Returns the size of the buffers for new documents.
+    std::size_t block_size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return block_size_;
+    }
+
+private:
+    void release(std::unique_ptr<detail::arena_slot> slot) {
+        const auto used = slot->resource->used();
+        // O(1) unless the document has outgrown its buffer
+        slot->value.reset();
+        slot->resource.reset();
+        std::lock_guard<std::mutex> lock(mutex_);
+        // the estimate follows a larger document at once, and decays by 1/16 per document
+        estimate_ = std::max(used, estimate_ - estimate_ / 16);
+        block_size_ = std::max(min_block_size_, (estimate_ + 1023) / 1024 * 1024);
+        if (free_.size() < max_free_buffers_) {
+            free_.push_back(std::move(slot));
+        }
+    }
+
+    const std::size_t min_block_size_;
+    const std::size_t max_free_buffers_;
+    mutable std::mutex mutex_;
+    std::size_t block_size_;
+    std::size_t estimate_ = 0;
+    std::vector<std::unique_ptr<detail::arena_slot>> free_;
+};
+
+}  // namespace json_access_helper
+
+#endif  // JSON_ACCESS_HELPER_ARENA_HPP_
@@ -0,0 +1,226 @@
+#ifndef JSON_ACCESS_HELPER_BATCH_HPP_
+#define JSON_ACCESS_HELPER_BATCH_HPP_
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <boost/json.hpp>
+
+#include "json_access_helper.hpp"
+
+namespace json_access_helper {
+
+namespace detail {
+
+// children[i][d]: the number of distinct tokens at depth d of the tags which share the first
+// d tokens with the i-th tag in the traversal plan. It is the capacity of a container
+// created at that depth.
+template <class... Tags>
+struct batch_traits {
+    using traits = multi_pointer_traits<Tags...>;
+    static constexpr std::size_t size = traits::size;
+    static constexpr std::size_t max_depth = traits::plan.max_depth;
+
+    static constexpr std::array<std::array<std::size_t, max_depth + 1>, size> children = [] {
+        std::array<std::array<std::size_t, max_depth + 1>, size> children = {};
+        const auto& spans = traits::spans;
+        for (std::size_t i = 0; i < size; ++i) {
+            const auto& span = spans[traits::plan.order[i]];
+            for (std::size_t d = 0; d < span.size; ++d) {
+                std::size_t n = 0;
+                for (std::size_t j = 0; j < size; ++j) {
+                    if (spans[j].size <= d || common_prefix(span, spans[j]) < d) {
+                        continue;
+                    }
+                    bool seen = false;
+                    for (std::size_t k = 0; k < j && !seen; ++k) {
+                        seen = spans[k].size > d && common_prefix(span, spans[k]) >= d
+                            && spans[k].data[d].key == spans[j].data[d].key;
+                    }
+                    n += seen ? 0 : 1;
+                }
+                children[i][d] = n;
+            }
+        }
+        return children;
+    }();
+};
+
+// same as the step of detail::emplace_path except that it returns nullptr instead of throwing, and
+// a created container reserves capacity for its children. The first value created is recorded
+// in created.
+inline boost::json::value* emplace_step(boost::json::value& node, const token& t, std::size_t capacity,
+                                        created_value& created) {
+    if (node.is_null()) {
+        if (created.empty()) {
+            created.container = &node;
+        }
+        if (t.kind == token_kind::key) {
+            node.emplace_object().reserve(capacity);
+        } else {
+            node.emplace_array().reserve(capacity);
+        }
+    }
+    if (auto obj = node.if_object()) {
+        const auto size = obj->size();
+        auto p = &(*obj)[t.key];
+        if (created.empty() && obj->size() != size) {
+            created.object = obj;
+        }
+        return p;
+    }
+    if (auto arr = node.if_array()) {
+        if (t.kind == token_kind::key) {
+            return nullptr;
+        }
+        auto index = t.kind == token_kind::index ? t.index : arr->size();
+        if (index > arr->size()) {
+            return nullptr;
+        }
+        if (index == arr->size()) {
+            arr->emplace_back(nullptr);
+            if (created.empty()) {
+                created.array = arr;
+            }
+        }
+        return &(*arr)[index];
+    }
+    return nullptr;
+}
+
+}  // namespace detail
+
+// Collects the values of several tags and writes them in one traversal.
+//
+// apply() visits the tags in the order of their pointers, and the objects and arrays on the
+// pointers shared by several tags are resolved (or created) once. A created object or array
+// reserves capacity for the children of the tags in the batch.
+// Tags with the same "-" token share the element appended for them.
+template <class... Tags>
+class write_batch {
+    static_assert(are_accessor_tags_v<Tags...>, "write_batch needs accessor tags");
+
+public:
+    static constexpr std::size_t size = sizeof...(Tags);
+
+    // Sets the value to write if the tag's value exists, like write.
+    template <class Tag>
+    write_batch& write(const Tag&, typename Tag::value_type value) {
+        return set<Tag>(mode::write, std::move(value));
+    }
+
+    // Sets the value to write creating the missing objects and arrays, like emplace.
+    template <class Tag>
+    write_batch& emplace(const Tag&, typename Tag::value_type value) {
+        return set<Tag>(mode::emplace, std::move(value));
+    }
+
+    // Removes the values.
+    void clear() noexcept {
+        modes_.fill(mode::none);
+        std::apply([](auto&... values) { (values.reset(), ...); }, values_);
+    }
+
+    bool empty() const noexcept {
+        for (auto m : modes_) {
+            if (m != mode::none) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Writes the values set to the batch in one traversal.
+    // Returns true for each tag, in the order of Tags, whose value was written. It is false
+    // for a tag without a value, a write whose value does not exist and an emplace which
+    // fails on a scalar or an array index. The objects and arrays created for an emplace which
+    // fails are removed again, so a false tag leaves the document as it was. If a store
+    // throws, the values created for its tag are removed and the tags before it stay written.
+    std::array<bool, size> apply(boost::json::value& jv) const {
+        using traits = typename detail::batch_traits<Tags...>::traits;
+        constexpr const auto& children = detail::batch_traits<Tags...>::children;
+
+        std::array<bool, size> written = {};
+        std::array<boost::json::value*, traits::plan.max_depth + 1> nodes = {};
+        nodes[0] = &jv;
+        std::size_t resolved = 0;  // number of tokens resolved for the previous tag
+        for (std::size_t i = 0; i < size; ++i) {
+            const auto tag = traits::plan.order[i];
+            if (modes_[tag] == mode::none) {
+                // the next tag shares with this one no more nodes than were resolved
+                resolved = traits::plan.shared[i] < resolved ? traits::plan.shared[i] : resolved;
+                continue;
+            }
+            const auto& span = traits::spans[tag];
+            auto depth = traits::plan.shared[i] < resolved ? traits::plan.shared[i] : resolved;
+            detail::created_value created;
+            std::size_t created_depth = 0;  // depth of the node in which the first value was created
+            while (depth < span.size) {
+                boost::json::value* next;
+                if (modes_[tag] == mode::emplace) {
+                    const bool none = created.empty();
+                    next = detail::emplace_step(*nodes[depth], span.data[depth], children[i][depth], created);
+                    if (none && !created.empty()) {
+                        created_depth = depth;
+                    }
+                } else {
+                    boost::json::error_code ec;
+                    next = detail::find(*nodes[depth], span.data + depth, span.data + depth + 1, ec);
+                }
+                if (!next) {
+                    break;
+                }
+                nodes[++depth] = next;
+            }
+            if (depth == span.size) {
+                try {
+                    store(tag, *nodes[depth], std::index_sequence_for<Tags...>());
+                } catch (...) {
+                    created.undo();
+                    throw;
+                }
+                written[tag] = true;
+            } else if (!created.empty()) {
+                // removes the values created for the tag, and the nodes inside them with them
+                created.undo();
+                depth = created_depth;
+            }
+            resolved = depth;
+        }
+        return written;
+    }
+
+private:
+    enum class mode : unsigned char { none, write, emplace };
+
+    template <class Tag>
+    write_batch& set(mode m, typename Tag::value_type&& value) {
+        constexpr auto index = detail::tag_index<Tag, Tags...>();
+        static_assert(index < size, "the tag is not in the batch");
+        std::get<index>(values_) = std::move(value);
+        modes_[index] = m;
+        return *this;
+    }
+
+    template <std::size_t... Is>
+    void store(std::size_t tag, boost::json::value& dst, std::index_sequence<Is...>) const {
+        ((tag == Is ? detail::store(dst, *std::get<Is>(values_)) : void()), ...);
+    }
+
+    std::tuple<std::optional<typename Tags::value_type>...> values_;
+    std::array<mode, size> modes_ = {};
+};
+
+// Makes an empty batch of the tags.
+template <class... Tags, class = std::enable_if_t<are_accessor_tags_v<Tags...>>>
+write_batch<Tags...> make_write_batch(const Tags&...) {
+    return write_batch<Tags...>();
+}
+
+}  // namespace json_access_helper
+
+#endif  // JSON_ACCESS_HELPER_BATCH_HPP_
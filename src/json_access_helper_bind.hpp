@@ -0,0 +1,223 @@
+#ifndef JSON_ACCESS_HELPER_BIND_HPP_
+#define JSON_ACCESS_HELPER_BIND_HPP_
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include <boost/json.hpp>
+
+#include "json_access_helper.hpp"
+
+namespace json_access_helper {
+
+namespace detail {
+
+// true if the value of Outer contains the value of Inner.
+template <class Outer, class Inner>
+constexpr bool contains_pointer() noexcept {
+    constexpr std::string_view outer = Outer::json_pointer;
+    constexpr std::string_view inner = Inner::json_pointer;
+    return inner.size() > outer.size() && inner.substr(0, outer.size()) == outer && inner[outer.size()] == '/';
+}
+
+}  // namespace detail
+
+// View of a document whose tags are resolved once.
+//
+// The view keeps a table of the values of the tags (and the errors of the tags not found),
+// so an access is a load from the table and does not depend on the depth of the pointers or
+// the size of the objects.
+// The table is resolved at the generation of the view. write() and reference() start a new
+// generation if the value of the tag contains the values of other tags, and the next non-const
+// access resolves the table again. A const access to a stale table falls back to the normal
+// lookup.
+// Boost.JSON has no modification counter, so a change of the document which is not made
+// through the view is not detected: call rebind() after it before the next access, since the
+// table may point to values which no longer exist.
+// Value is const for a view of a const document, which gives only const access. Accesses
+// through a const view do not modify it, so they are safe from several threads if the
+// document is not modified. The document must outlive the view.
+template <class Value, class... Tags>
+class basic_bound_view {
+    static_assert(are_accessor_tags_v<Tags...>, "bound_view needs accessor tags");
+
+public:
+    explicit basic_bound_view(Value& jv) noexcept : jv_(&jv) {
+        rebind();
+    }
+
+    // Resolves the values of all tags again.
+    void rebind() noexcept {
+        rebind(std::index_sequence_for<Tags...>());
+        resolved_ = generation_;
+    }
+
+    // Returns true if the table was resolved at the current generation.
+    bool valid() const noexcept {
+        return resolved_ == generation_;
+    }
+
+    Value& document() noexcept {
+        return *jv_;
+    }
+
+    const boost::json::value& document() const noexcept {
+        return *jv_;
+    }
+
+    // Starts a new generation if the value of the tag contains the values of other tags,
+    // which a change of the value may move.
+    template <class Tag, class = std::enable_if_t<is_accessor_tag_v<Tag>>>
+    void changed(const Tag&) noexcept {
+        if constexpr ((detail::contains_pointer<Tag, Tags>() || ...)) {
+            ++generation_;
+        }
+    }
+
+    // Returns the value of the tag, or nullptr if it does not exist.
+    template <class Tag>
+    Value* find(boost::json::error_code& ec) noexcept {
+        if (!valid()) {
+            rebind();
+        }
+        return lookup<Tag>(ec);
+    }
+
+    template <class Tag>
+    const boost::json::value* find(boost::json::error_code& ec) const noexcept {
+        if (!valid()) {
+            return detail::find<Tag>(std::as_const(*jv_), ec);
+        }
+        return lookup<Tag>(ec);
+    }
+
+private:
+    template <std::size_t... Is>
+    void rebind(std::index_sequence<Is...>) noexcept {
+        ((errors_[Is] = {}, values_[Is] = detail::find<Tags>(*jv_, errors_[Is])), ...);
+    }
+
+    template <class Tag>
+    Value* lookup(boost::json::error_code& ec) const noexcept {
+        constexpr auto index = detail::tag_index<Tag, Tags...>();
+        static_assert(index < sizeof...(Tags), "the tag is not bound to the view");
+        if (!values_[index]) {
+            ec = errors_[index];
+        }
+        return values_[index];
+    }
+
+    Value* jv_;
+    std::array<Value*, sizeof...(Tags)> values_ = {};
+    std::array<boost::json::error_code, sizeof...(Tags)> errors_ = {};
+    std::size_t generation_ = 0;
+    std::size_t resolved_ = 0;
+};
+
+template <class... Tags>
+using bound_view = basic_bound_view<boost::json::value, Tags...>;
+
+template <class... Tags>
+using const_bound_view = basic_bound_view<const boost::json::value, Tags...>;
+
+// Binds the tags to the document.
+template <class... Tags, class = std::enable_if_t<are_accessor_tags_v<Tags...>>>
+bound_view<Tags...> bind(boost::json::value& jv, const Tags&...) {
+    return bound_view<Tags...>(jv);
+}
+
+// Binds the tags to the document for reading only.
+template <class... Tags, class = std::enable_if_t<are_accessor_tags_v<Tags...>>>
+const_bound_view<Tags...> bind(const boost::json::value& jv, const Tags&...) {
+    return const_bound_view<Tags...>(jv);
+}
+
+namespace detail {
+
+template <class Tag, class View>
+typename Tag::value_type read_bound(View& view) {
+    boost::json::error_code ec;
+    auto ref = view.template find<Tag>(ec);
+    if (!ref) {
+        throw boost::system::system_error(ec);
+    }
+    return boost::json::value_to<typename Tag::value_type>(*ref);
+}
+
+template <class Tag, class View>
+boost::json::result<typename Tag::value_type> try_read_bound(View& view) {
+    boost::json::error_code ec;
+    auto ref = view.template find<Tag>(ec);
+    if (!ref) {
+        return ec;
+    }
+    return boost::json::try_value_to<typename Tag::value_type>(*ref);
+}
+
+}  // namespace detail
+
+// Reads the value of the tag through the view.
+// Throws exception if any error occurs.
+template <class Tag, class Value, class... Tags, class = std::enable_if_t<is_accessor_tag_v<Tag>>>
+typename Tag::value_type read(const basic_bound_view<Value, Tags...>& view, const Tag&) {
+    return detail::read_bound<Tag>(view);
+}
+
+// Tries to read the value of the tag through the view.
+template <class Tag, class Value, class... Tags, class = std::enable_if_t<is_accessor_tag_v<Tag>>>
+boost::json::result<typename Tag::value_type> try_read(const basic_bound_view<Value, Tags...>& view, const Tag&) {
+    return detail::try_read_bound<Tag>(view);
+}
+
+// A non-const view resolves a stale table again before the read.
+template <class Tag, class Value, class... Tags, class = std::enable_if_t<is_accessor_tag_v<Tag>>>
+typename Tag::value_type read(basic_bound_view<Value, Tags...>& view, const Tag&) {
+    return detail::read_bound<Tag>(view);
+}
+
+template <class Tag, class Value, class... Tags, class = std::enable_if_t<is_accessor_tag_v<Tag>>>
+boost::json::result<typename Tag::value_type> try_read(basic_bound_view<Value, Tags...>& view, const Tag&) {
+    return detail::try_read_bound<Tag>(view);
+}
+
+// Writes the value of the tag through the view, reusing the storage of the existing value.
+// Returns false if the value does not exist.
+template <class Tag, class... Tags, class = std::enable_if_t<is_accessor_tag_v<Tag>>>
+bool write(bound_view<Tags...>& view, const Tag&, const typename Tag::value_type& value) {
+    boost::json::error_code ec;
+    auto ref = view.template find<Tag>(ec);
+    if (!ref) {
+        return false;
+    }
+    view.changed(Tag());
+    detail::store(*ref, value);
+    return true;
+}
+
+// Returns the value of the tag through the view, or nullptr if it does not exist.
+// A new generation is started if the value contains the values of other tags, so the pointer
+// must not be used to change them after the next non-const access.
+template <class Tag, class Value, class... Tags, class = std::enable_if_t<is_accessor_tag_v<Tag>>>
+Value* reference(basic_bound_view<Value, Tags...>& view, const Tag&) {
+    boost::json::error_code ec;
+    auto ref = view.template find<Tag>(ec);
+    if constexpr (!std::is_const_v<Value>) {
+        if (ref) {
+            view.changed(Tag());
+        }
+    }
+    return ref;
+}
+
+template <class Tag, class Value, class... Tags, class = std::enable_if_t<is_accessor_tag_v<Tag>>>
+const boost::json::value* reference(const basic_bound_view<Value, Tags...>& view, const Tag&) {
+    boost::json::error_code ec;
+    return view.template find<Tag>(ec);
+}
+
+}  // namespace json_access_helper
+
+#endif  // JSON_ACCESS_HELPER_BIND_HPP_
@@ -0,0 +1,281 @@
+#ifndef JSON_ACCESS_HELPER_BUNDLE_HPP_
+#define JSON_ACCESS_HELPER_BUNDLE_HPP_
+
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <utility>
+
+#include <boost/json.hpp>
+
+#include "json_access_helper.hpp"
+
+namespace json_access_helper {
+
+namespace detail {
+
+template <class Bundle, class... Tags, std::size_t... Is>
+void decode_bundle(const boost::json::value& jv, Bundle& out, boost::json::error_code& ec,
+                   std::tuple<Tags...>*, std::index_sequence<Is...>) {
+    std::array<boost::json::error_code, sizeof...(Tags)> ecs;
+    auto refs = find_all<Tags...>(jv, ecs);
+    constexpr auto members = Bundle::members();
+    // stops at the first error in the order of the members
+    ((refs[Is] ? load(*refs[Is], out.*std::get<Is>(members), ec) : void(ec = ecs[Is]), !ec) && ...);
+}
+
+template <class Bundle>
+void decode_bundle(const boost::json::value& jv, Bundle& out, boost::json::error_code& ec) {
+    using tags = typename Bundle::tags;
+    decode_bundle(jv, out, ec, static_cast<tags*>(nullptr),
+                  std::make_index_sequence<std::tuple_size_v<tags>>());
+}
+
+template <class Bundle, std::size_t I>
+void store_member(boost::json::value& dst, const Bundle& bundle) {
+    store(dst, bundle.*std::get<I>(Bundle::members()));
+}
+
+// emplaces the values of all tags in one traversal.
+// The tags are visited in the order of traversal_plan, and each tag reuses the nodes of the
+// tokens it shares with the previous one. The reused nodes stay valid because the values
+// emplaced after them are deeper than them.
+// If a tag throws, the values created for it are removed as detail::emplace does, and the
+// tags before it stay written.
+template <class Bundle, class... Tags, std::size_t... Is>
+void encode_bundle(boost::json::value& jv, const Bundle& bundle, std::tuple<Tags...>*,
+                   std::index_sequence<Is...>) {
+    using traits = multi_pointer_traits<Tags...>;
+    using store_function = void (*)(boost::json::value&, const Bundle&);
+    static constexpr std::array<store_function, sizeof...(Tags)> stores = {{&store_member<Bundle, Is>...}};
+    std::array<boost::json::value*, traits::plan.max_depth + 1> nodes = {};
+    nodes[0] = &jv;
+    for (std::size_t i = 0; i < traits::size; ++i) {
+        auto tag = traits::plan.order[i];
+        const auto& span = traits::spans[tag];
+        auto depth = traits::plan.shared[i];
+        // "-" appends a new element for each tag
+        for (std::size_t k = 0; k < depth; ++k) {
+            if (span.data[k].kind == token_kind::past_the_end) {
+                depth = k;
+                break;
+            }
+        }
+        created_value created;
+        try {
+            for (; depth < span.size; ++depth) {
+                nodes[depth + 1] = &emplace_path(*nodes[depth], span.data + depth, span.data + depth + 1, created);
+            }
+            stores[tag](*nodes[span.size], bundle);
+        } catch (...) {
+            created.undo();
+            throw;
+        }
+    }
+}
+
+template <class Bundle>
+void encode_bundle(boost::json::value& jv, const Bundle& bundle) {
+    using tags = typename Bundle::tags;
+    encode_bundle(jv, bundle, static_cast<tags*>(nullptr),
+                  std::make_index_sequence<std::tuple_size_v<tags>>());
+}
+
+}  // namespace detail
+
+}  // namespace json_access_helper
+
+#define JSON_ACCESS_HELPER_NARGS_(...)                                                      \
+    JSON_ACCESS_HELPER_NARGS_IMPL_(__VA_ARGS__,                                             \
+        64, 63, 62, 61, 60, 59, 58, 57, 56, 55, 54, 53, 52, 51, 50, 49,                     \
+        48, 47, 46, 45, 44, 43, 42, 41, 40, 39, 38, 37, 36, 35, 34, 33,                     \
+        32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17,                     \
+        16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1)
+
+#define JSON_ACCESS_HELPER_NARGS_IMPL_(                                                     \
+    _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16,                  \
+    _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32,         \
+    _33, _34, _35, _36, _37, _38, _39, _40, _41, _42, _43, _44, _45, _46, _47, _48,         \
+    _49, _50, _51, _52, _53, _54, _55, _56, _57, _58, _59, _60, _61, _62, _63, _64,         \
+    N, ...) N
+
+#define JSON_ACCESS_HELPER_CONCAT_(a, b, c) JSON_ACCESS_HELPER_CONCAT_IMPL_(a, b, c)
+#define JSON_ACCESS_HELPER_CONCAT_IMPL_(a, b, c) a##b##c
+
+// expands m(d, x) for each x of the arguments (up to 64).
+#define JSON_ACCESS_HELPER_FOR_EACH_(m, d, ...)                                             \
+    JSON_ACCESS_HELPER_CONCAT_(JSON_ACCESS_HELPER_FOR_EACH_,                                \
+                               JSON_ACCESS_HELPER_NARGS_(__VA_ARGS__), _)(m, d, __VA_ARGS__)
+
+#define JSON_ACCESS_HELPER_FOR_EACH_1_(m, d, x) m(d, x)
+#define JSON_ACCESS_HELPER_FOR_EACH_2_(m, d, x, ...)                                        \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_1_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_3_(m, d, x, ...)                                        \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_2_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_4_(m, d, x, ...)                                        \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_3_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_5_(m, d, x, ...)                                        \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_4_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_6_(m, d, x, ...)                                        \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_5_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_7_(m, d, x, ...)                                        \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_6_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_8_(m, d, x, ...)                                        \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_7_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_9_(m, d, x, ...)                                        \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_8_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_10_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_9_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_11_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_10_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_12_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_11_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_13_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_12_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_14_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_13_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_15_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_14_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_16_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_15_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_17_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_16_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_18_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_17_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_19_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_18_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_20_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_19_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_21_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_20_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_22_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_21_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_23_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_22_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_24_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_23_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_25_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_24_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_26_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_25_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_27_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_26_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_28_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_27_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_29_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_28_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_30_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_29_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_31_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_30_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_32_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_31_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_33_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_32_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_34_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_33_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_35_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_34_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_36_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_35_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_37_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_36_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_38_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_37_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_39_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_38_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_40_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_39_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_41_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_40_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_42_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_41_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_43_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_42_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_44_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_43_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_45_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_44_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_46_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_45_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_47_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_46_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_48_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_47_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_49_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_48_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_50_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_49_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_51_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_50_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_52_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_51_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_53_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_52_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_54_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_53_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_55_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_54_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_56_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_55_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_57_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_56_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_58_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_57_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_59_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_58_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_60_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_59_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_61_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_60_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_62_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_61_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_63_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_62_(m, d, __VA_ARGS__)
+#define JSON_ACCESS_HELPER_FOR_EACH_64_(m, d, x, ...)                                       \
+    m(d, x) JSON_ACCESS_HELPER_FOR_EACH_63_(m, d, __VA_ARGS__)
+
+#define JSON_ACCESS_HELPER_BUNDLE_FIELD_(Bundle, Tag) Tag##T::value_type Tag;
+#define JSON_ACCESS_HELPER_BUNDLE_TAG_(Bundle, Tag) , std::tuple<Tag##T>()
+#define JSON_ACCESS_HELPER_BUNDLE_MEMBER_(Bundle, Tag) , std::make_tuple(&Bundle::Tag)
+
+// Defines a struct which has a member for each tag.
+// The tags must be defined in the same namespace beforehand.
+#define DEFINE_JSON_ACCESSOR_BUNDLE(Bundle, ...)                                            \
+    struct Bundle {                                                                         \
+        JSON_ACCESS_HELPER_FOR_EACH_(JSON_ACCESS_HELPER_BUNDLE_FIELD_, Bundle, __VA_ARGS__) \
+                                                                                            \
+        using tags = decltype(std::tuple_cat(std::tuple<>() JSON_ACCESS_HELPER_FOR_EACH_(   \
+            JSON_ACCESS_HELPER_BUNDLE_TAG_, Bundle, __VA_ARGS__)));                         \
+                                                                                            \
+        static constexpr auto members() {                                                   \
+            return std::tuple_cat(std::tuple<>() JSON_ACCESS_HELPER_FOR_EACH_(              \
+                JSON_ACCESS_HELPER_BUNDLE_MEMBER_, Bundle, __VA_ARGS__));                   \
+        }                                                                                   \
+                                                                                            \
+        static Bundle decode(const boost::json::value& jv) {                                \
+            Bundle bundle{};                                                                \
+            boost::json::error_code ec;                                                     \
+            ::json_access_helper::detail::decode_bundle(jv, bundle, ec);                    \
+            if (ec) {                                                                       \
+                throw boost::system::system_error(ec);                                      \
+            }                                                                               \
+            return bundle;                                                                  \
+        }                                                                                   \
+                                                                                            \
+        static boost::json::result<Bundle> try_decode(const boost::json::value& jv) {       \
+            Bundle bundle{};                                                                \
+            boost::json::error_code ec;                                                     \
+            ::json_access_helper::detail::decode_bundle(jv, bundle, ec);                    \
+            if (ec) {                                                                       \
+                return ec;                                                                  \
+            }                                                                               \
+            return bundle;                                                                  \
+        }                                                                                   \
+                                                                                            \
+        friend void encode(const Bundle& bundle, boost::json::value& jv) {                  \
+            ::json_access_helper::detail::encode_bundle(jv, bundle);                        \
+        }                                                                                   \
+    };
+
+#endif  // JSON_ACCESS_HELPER_BUNDLE_HPP_
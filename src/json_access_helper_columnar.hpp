@@ -0,0 +1,387 @@
+#ifndef JSON_ACCESS_HELPER_COLUMNAR_HPP_
+#define JSON_ACCESS_HELPER_COLUMNAR_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <boost/json.hpp>
+
+#include "json_access_helper.hpp"
+#include "json_access_helper_ndjson.hpp"
+
+namespace json_access_helper {
+
+// Bitmap of the rows which have a value. Bit i of the words is row i, from the least
+// significant bit.
+class validity_bitmap {
+public:
+    std::size_t size() const noexcept {
+        return size_;
+    }
+
+    bool test(std::size_t i) const noexcept {
+        return (words_[i / 64] >> (i % 64)) & 1;
+    }
+
+    // the number of the rows without a value
+    std::size_t null_count() const noexcept {
+        return nulls_;
+    }
+
+    const std::vector<std::uint64_t>& words() const noexcept {
+        return words_;
+    }
+
+    void push_back(bool valid) {
+        if (size_ % 64 == 0) {
+            words_.push_back(0);
+        }
+        words_.back() |= static_cast<std::uint64_t>(valid) << (size_ % 64);
+        nulls_ += valid ? 0 : 1;
+        ++size_;
+    }
+
+    void reserve(std::size_t n) {
+        words_.reserve((n + 63) / 64);
+    }
+
+    void clear() noexcept {
+        words_.clear();
+        size_ = 0;
+        nulls_ = 0;
+    }
+
+private:
+    std::vector<std::uint64_t> words_;
+    std::size_t size_ = 0;
+    std::size_t nulls_ = 0;
+};
+
+// Column of an arithmetic type. A row without a value has T().
+// bool is stored as std::uint8_t so that data() is contiguous.
+template <class T>
+class value_column {
+    static_assert(std::is_arithmetic_v<T>, "value_column needs an arithmetic type");
+
+public:
+    using value_type = T;
+    using storage_type = std::conditional_t<std::is_same_v<T, bool>, std::uint8_t, T>;
+
+    std::size_t size() const noexcept {
+        return values_.size();
+    }
+
+    bool valid(std::size_t i) const noexcept {
+        return validity_.test(i);
+    }
+
+    T operator[](std::size_t i) const noexcept {
+        return static_cast<T>(values_[i]);
+    }
+
+    const storage_type* data() const noexcept {
+        return values_.data();
+    }
+
+    const std::vector<storage_type>& values() const noexcept {
+        return values_;
+    }
+
+    const validity_bitmap& validity() const noexcept {
+        return validity_;
+    }
+
+    void push_back(T value) {
+        values_.push_back(static_cast<storage_type>(value));
+        validity_.push_back(true);
+    }
+
+    void push_null() {
+        values_.push_back(storage_type());
+        validity_.push_back(false);
+    }
+
+    // appends the value converted from jv, or null if jv is nullptr, null or not convertible.
+    void append(const boost::json::value* jv) {
+        if (jv && !jv->is_null()) {
+            if (auto r = boost::json::try_value_to<T>(*jv)) {
+                push_back(*r);
+                return;
+            }
+        }
+        push_null();
+    }
+
+    void reserve(std::size_t rows) {
+        values_.reserve(rows);
+        validity_.reserve(rows);
+    }
+
+    void clear() noexcept {
+        values_.clear();
+        validity_.clear();
+    }
+
+private:
+    std::vector<storage_type> values_;
+    validity_bitmap validity_;
+};
+
+// Column of strings. The characters of all rows are stored in bytes(), and row i is
+// [offsets()[i], offsets()[i + 1]). A row without a value is empty.
+class string_column {
+public:
+    using value_type = std::string_view;
+
+    std::size_t size() const noexcept {
+        return offsets_.size() - 1;
+    }
+
+    bool valid(std::size_t i) const noexcept {
+        return validity_.test(i);
+    }
+
+    std::string_view operator[](std::size_t i) const noexcept {
+        return std::string_view(bytes_.data() + offsets_[i], offsets_[i + 1] - offsets_[i]);
+    }
+
+    const std::vector<std::size_t>& offsets() const noexcept {
+        return offsets_;
+    }
+
+    const std::string& bytes() const noexcept {
+        return bytes_;
+    }
+
+    const validity_bitmap& validity() const noexcept {
+        return validity_;
+    }
+
+    void push_back(std::string_view value) {
+        bytes_.append(value.data(), value.size());
+        offsets_.push_back(bytes_.size());
+        validity_.push_back(true);
+    }
+
+    void push_null() {
+        offsets_.push_back(bytes_.size());
+        validity_.push_back(false);
+    }
+
+    // appends the string of jv, or null if jv is nullptr or not a string.
+    void append(const boost::json::value* jv) {
+        if (auto str = jv ? jv->if_string() : nullptr) {
+            push_back(std::string_view(str->data(), str->size()));
+        } else {
+            push_null();
+        }
+    }
+
+    void reserve(std::size_t rows, std::size_t bytes = 0) {
+        offsets_.reserve(rows + 1);
+        bytes_.reserve(bytes);
+        validity_.reserve(rows);
+    }
+
+    void clear() noexcept {
+        offsets_.assign(1, 0);
+        bytes_.clear();
+        validity_.clear();
+    }
+
+private:
+    std::vector<std::size_t> offsets_ = {0};
+    std::string bytes_;
+    validity_bitmap validity_;
+};
+
+namespace detail {
+
+template <class T, class = void>
+struct column_for {
+    static_assert(std::is_arithmetic_v<T>, "a column needs an arithmetic or string type");
+    using type = value_column<T>;
+};
+
+template <class T>
+struct column_for<T, std::enable_if_t<std::is_convertible_v<const T&, std::string_view>>> {
+    using type = string_column;
+};
+
+}  // namespace detail
+
+template <class Tag>
+using column_t = typename detail::column_for<typename Tag::value_type>::type;
+
+namespace detail {
+
+// tag of the same pointer as Tag whose value is a view of the text.
+template <class Tag>
+struct string_view_tag : accessor_tag {
+    using value_type = std::string_view;
+    static constexpr std::string_view json_pointer = Tag::json_pointer;
+};
+
+// the tag extracted for the column of Tag. A string column is appended from a view of the
+// text, so that the value is copied only into the column.
+template <class Tag>
+using column_input_t = std::conditional_t<std::is_same_v<column_t<Tag>, string_column>, string_view_tag<Tag>, Tag>;
+
+}  // namespace detail
+
+// ndjson_extractor for make_columns. It is kept between calls to reuse its threads.
+template <class... Tags>
+using column_extractor = ndjson_extractor<detail::column_input_t<Tags>...>;
+
+// Columns of the values of the tags, one row for each document.
+//
+// The values of a tag are stored in one contiguous column: arithmetic types in a
+// value_column, and strings in a string_column of offsets and bytes. A row is null if the
+// value does not exist, is null or cannot be converted, which is recorded in the validity
+// bitmap of the column.
+template <class... Tags>
+class column_table {
+    static_assert(are_accessor_tags_v<Tags...>, "column_table needs accessor tags");
+
+public:
+    using result_type = std::tuple<boost::json::result<typename Tags::value_type>...>;
+
+    std::size_t size() const noexcept {
+        return rows_;
+    }
+
+    template <class Tag>
+    const column_t<Tag>& column(const Tag& = {}) const noexcept {
+        constexpr auto index = detail::tag_index<Tag, Tags...>();
+        static_assert(index < sizeof...(Tags), "the tag is not a column of the table");
+        return std::get<index>(columns_);
+    }
+
+    void reserve(std::size_t rows) {
+        std::apply([&](auto&... columns) { (columns.reserve(rows), ...); }, columns_);
+    }
+
+    void clear() noexcept {
+        std::apply([](auto&... columns) { (columns.clear(), ...); }, columns_);
+        rows_ = 0;
+    }
+
+    // Appends the values of the document as a row.
+    void append(const boost::json::value& jv) {
+        append(jv, std::index_sequence_for<Tags...>());
+        ++rows_;
+    }
+
+    // Appends the results of an extractor as a row.
+    void append(const result_type& results) {
+        append(results, std::index_sequence_for<Tags...>());
+        ++rows_;
+    }
+
+    // Appends the results of a column_extractor for a line of JSON Lines text as a row.
+    // line() returns the text of the line. It is called only for a string which is not a view
+    // of the text, e.g. with escapes, to extract the string again.
+    template <class Line>
+    void append_line(const typename column_extractor<Tags...>::result_type& results, Line&& line) {
+        append_line(results, line, std::index_sequence_for<Tags...>());
+        ++rows_;
+    }
+
+private:
+    template <std::size_t... Is>
+    void append(const boost::json::value& jv, std::index_sequence<Is...>) {
+        boost::json::error_code ec;
+        (std::get<Is>(columns_).append(detail::find<Tags>(jv, ec)), ...);
+    }
+
+    template <std::size_t... Is>
+    void append(const result_type& results, std::index_sequence<Is...>) {
+        (append_result(std::get<Is>(columns_), std::get<Is>(results)), ...);
+    }
+
+    template <class Results, class Line, std::size_t... Is>
+    void append_line(const Results& results, Line& line, std::index_sequence<Is...>) {
+        (append_line_result<Is>(std::get<Is>(results), line), ...);
+    }
+
+    template <std::size_t I, class T, class Line>
+    void append_line_result(const boost::json::result<T>& result, Line& line) {
+        using tag = std::tuple_element_t<I, std::tuple<Tags...>>;
+        auto& column = std::get<I>(columns_);
+        if constexpr (std::is_same_v<T, std::string_view>) {
+            if (!result && result.error() == boost::json::error::not_exact) {
+                append_result(column, std::get<0>(try_extract(line(), tag())));
+                return;
+            }
+        }
+        append_result(column, result);
+    }
+
+    template <class Column, class T>
+    static void append_result(Column& column, const boost::json::result<T>& result) {
+        if (result) {
+            column.push_back(*result);
+        } else {
+            column.push_null();
+        }
+    }
+
+    std::tuple<column_t<Tags>...> columns_;
+    std::size_t rows_ = 0;
+};
+
+// Makes the columns of the tags from a range of documents.
+template <class Range, class... Tags,
+          class = std::enable_if_t<are_accessor_tags_v<Tags...>
+              && std::is_same_v<std::decay_t<decltype(*std::begin(std::declval<const Range&>()))>,
+                                boost::json::value>>>
+column_table<Tags...> make_columns(const Range& docs, const Tags&...) {
+    column_table<Tags...> table;
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<
+                      decltype(std::begin(docs))>::iterator_category>) {
+        table.reserve(static_cast<std::size_t>(std::distance(std::begin(docs), std::end(docs))));
+    }
+    for (const auto& jv : docs) {
+        table.append(jv);
+    }
+    return table;
+}
+
+// Makes the columns of the tags from JSON Lines text with the threads of the extractor, one
+// row for each line which is not blank.
+template <class... Tags, class = std::enable_if_t<are_accessor_tags_v<Tags...>>>
+column_table<Tags...> make_columns(std::string_view text, column_extractor<Tags...>& extractor, const Tags&...) {
+    column_table<Tags...> table;
+    // the lines are passed in order, so the text of a line is found from the previous one
+    auto rest = text;
+    std::size_t next = 0;
+    extractor.try_extract(text, [&](std::size_t line, const auto& results) {
+        table.append_line(results, [&] {
+            for (; next < line; ++next) {
+                const auto eol = rest.find('\n');
+                rest.remove_prefix(eol == std::string_view::npos ? rest.size() : eol + 1);
+            }
+            return rest.substr(0, rest.find('\n'));
+        });
+    });
+    return table;
+}
+
+// Makes the columns of the tags from JSON Lines text with std::thread::hardware_concurrency()
+// threads, one row for each line which is not blank.
+template <class... Tags, class = std::enable_if_t<are_accessor_tags_v<Tags...>>>
+column_table<Tags...> make_columns(std::string_view text, const Tags&... tags) {
+    column_extractor<Tags...> extractor;
+    return make_columns(text, extractor, tags...);
+}
+
+}  // namespace json_access_helper
+
+#endif  // JSON_ACCESS_HELPER_COLUMNAR_HPP_
@@ -0,0 +1,536 @@
+#ifndef JSON_ACCESS_HELPER_EXTRACT_HPP_
+#define JSON_ACCESS_HELPER_EXTRACT_HPP_
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <boost/json.hpp>
+#include <boost/json/basic_parser_impl.hpp>
+
+#include "json_access_helper.hpp"
+
+namespace json_access_helper {
+
+namespace detail {
+
+// basic_parser handler that converts only the values of the tags.
+//
+// The handler tracks the tokens of the current path and skips every value that is not
+// on the path of any tag. A matched scalar is converted directly, and a matched array or
+// object is built with value_stack on the handler's buffer before the conversion.
+// A result of a Boost.JSON type is copied to the default resource, so it outlives the
+// handler's buffer.
+// A std::string_view value refers to the input text, so it is an error (not_exact) if the
+// string has escapes or is inside a matched array or object.
+template <class... Tags>
+class extract_handler {
+public:
+    static constexpr std::size_t max_object_size = static_cast<std::size_t>(-1);
+    static constexpr std::size_t max_array_size = static_cast<std::size_t>(-1);
+    static constexpr std::size_t max_key_size = static_cast<std::size_t>(-1);
+    static constexpr std::size_t max_string_size = static_cast<std::size_t>(-1);
+
+    using result_type = std::tuple<boost::json::result<typename Tags::value_type>...>;
+
+    // the stack keeps its own memory on the default resource between documents, and only the
+    // values it makes are on resource_, which is released for each document
+    extract_handler()
+        : resource_(buffer_, sizeof(buffer_)) {}
+
+    extract_handler(const extract_handler&) = delete;
+    extract_handler& operator=(const extract_handler&) = delete;
+
+    // true if the parser was stopped because every tag had been resolved.
+    bool finished() const noexcept {
+        return finished_;
+    }
+
+    result_type& results() noexcept {
+        return results_;
+    }
+
+    // sets the text being parsed, to which std::string_view values refer.
+    void set_input(std::string_view text) noexcept {
+        input_ = text;
+    }
+
+    // sets the error to the tags not resolved yet.
+    void fail(const boost::json::error_code& ec) {
+        for_each(~resolved_, [&](auto i) {
+            std::get<decltype(i)::value>(results_) = ec;
+        });
+        resolved_.set();
+    }
+
+    // sets the error to all tags, including the tags resolved already.
+    void fail_all(const boost::json::error_code& ec) {
+        resolved_.reset();
+        fail(ec);
+    }
+
+    bool on_document_begin(boost::json::error_code&) {
+        frames_.clear();
+        key_.clear();
+        chars_.clear();
+        resolved_.reset();
+        results_ = result_type(boost::json::result<typename Tags::value_type>(
+            boost::json::error_code(boost::json::error::not_found))...);
+        skip_depth_ = 0;
+        capture_depth_ = 0;
+        capture_level_ = 0;
+        in_key_ = false;
+        in_string_ = false;
+        finished_ = false;
+        resource_.release();
+        return true;
+    }
+
+    // the tags not resolved yet are failed by the caller, which checks the text after the
+    // document first.
+    bool on_document_end(boost::json::error_code&) {
+        return true;
+    }
+
+    bool on_object_begin(boost::json::error_code&) {
+        return begin_container(false);
+    }
+
+    bool on_object_end(std::size_t n, boost::json::error_code& ec) {
+        return end_container(false, n, ec);
+    }
+
+    bool on_array_begin(boost::json::error_code&) {
+        return begin_container(true);
+    }
+
+    bool on_array_end(std::size_t n, boost::json::error_code& ec) {
+        return end_container(true, n, ec);
+    }
+
+    bool on_key_part(boost::json::string_view s, std::size_t, boost::json::error_code&) {
+        if (capture_level_ > 0) {
+            stack_.push_chars(s);
+        } else if (skip_depth_ == 0) {
+            if (!in_key_) {
+                key_.clear();
+                in_key_ = true;
+            }
+            key_.append(s.data(), s.size());
+        }
+        return true;
+    }
+
+    bool on_key(boost::json::string_view s, std::size_t, boost::json::error_code&) {
+        if (capture_level_ > 0) {
+            stack_.push_key(s);
+        } else if (skip_depth_ == 0) {
+            std::string_view key = s;
+            if (in_key_) {
+                key_.append(s.data(), s.size());
+                key = key_;
+                in_key_ = false;
+            }
+            match_key(key);
+        }
+        return true;
+    }
+
+    bool on_string_part(boost::json::string_view s, std::size_t, boost::json::error_code&) {
+        if (capture_level_ > 0) {
+            stack_.push_chars(s);
+        } else if (skip_depth_ == 0) {
+            if (!in_string_) {
+                chars_.clear();
+                in_string_ = true;
+            }
+            chars_.append(s.data(), s.size());
+        }
+        return true;
+    }
+
+    bool on_string(boost::json::string_view s, std::size_t, boost::json::error_code& ec) {
+        if (capture_level_ > 0) {
+            stack_.push_string(s);
+            return true;
+        }
+        if (skip_depth_ > 0) {
+            return true;
+        }
+        std::string_view str = s;
+        if (in_string_) {
+            chars_.append(s.data(), s.size());
+            str = chars_;
+            in_string_ = false;
+        }
+        return scalar(ec, [&] { return boost::json::value(boost::json::string_view(str), storage()); }, &str);
+    }
+
+    bool on_number_part(boost::json::string_view, boost::json::error_code&) {
+        return true;
+    }
+
+    bool on_int64(std::int64_t i, boost::json::string_view, boost::json::error_code& ec) {
+        if (capture_level_ > 0) {
+            stack_.push_int64(i);
+            return true;
+        }
+        return skip_depth_ > 0 || scalar(ec, [&] { return boost::json::value(i); });
+    }
+
+    bool on_uint64(std::uint64_t u, boost::json::string_view, boost::json::error_code& ec) {
+        if (capture_level_ > 0) {
+            stack_.push_uint64(u);
+            return true;
+        }
+        return skip_depth_ > 0 || scalar(ec, [&] { return boost::json::value(u); });
+    }
+
+    bool on_double(double d, boost::json::string_view, boost::json::error_code& ec) {
+        if (capture_level_ > 0) {
+            stack_.push_double(d);
+            return true;
+        }
+        return skip_depth_ > 0 || scalar(ec, [&] { return boost::json::value(d); });
+    }
+
+    bool on_bool(bool b, boost::json::error_code& ec) {
+        if (capture_level_ > 0) {
+            stack_.push_bool(b);
+            return true;
+        }
+        return skip_depth_ > 0 || scalar(ec, [&] { return boost::json::value(b); });
+    }
+
+    bool on_null(boost::json::error_code& ec) {
+        if (capture_level_ > 0) {
+            stack_.push_null();
+            return true;
+        }
+        return skip_depth_ > 0 || scalar(ec, [] { return boost::json::value(nullptr); });
+    }
+
+    bool on_comment_part(boost::json::string_view, boost::json::error_code&) {
+        return true;
+    }
+
+    bool on_comment(boost::json::string_view, boost::json::error_code&) {
+        return true;
+    }
+
+private:
+    using traits = multi_pointer_traits<Tags...>;
+    using mask = std::bitset<sizeof...(Tags)>;
+
+    struct frame {
+        mask active;  // tags whose pointers continue below this container
+        std::size_t index;
+        bool is_array;
+    };
+
+    template <class F>
+    static void for_each(const mask& tags, F&& f) {
+        for_each(tags, f, std::index_sequence_for<Tags...>());
+    }
+
+    template <class F, std::size_t... Is>
+    static void for_each(const mask& tags, F& f, std::index_sequence<Is...>) {
+        ((tags[Is] ? f(std::integral_constant<std::size_t, Is>()) : void()), ...);
+    }
+
+    boost::json::storage_ptr storage() noexcept {
+        return boost::json::storage_ptr(&resource_);
+    }
+
+    void match_key(std::string_view key) {
+        auto depth = frames_.size() - 1;
+        pending_.reset();
+        for (std::size_t i = 0; i < traits::size; ++i) {
+            if (frames_.back().active[i] && traits::spans[i].data[depth].key == key) {
+                pending_.set(i);
+            }
+        }
+    }
+
+    // returns the tags matching the value that begins, split into the tags that end at the
+    // value and the tags that continue below it.
+    std::pair<mask, mask> begin_value() {
+        mask candidates;
+        if (frames_.empty()) {
+            candidates.set();
+        } else if (frames_.back().is_array) {
+            auto& f = frames_.back();
+            auto index = f.index++;
+            auto depth = frames_.size() - 1;
+            for (std::size_t i = 0; i < traits::size; ++i) {
+                const auto& t = traits::spans[i].data[depth];
+                if (f.active[i] && t.kind == token_kind::index && t.index == index) {
+                    candidates.set(i);
+                }
+            }
+        } else {
+            candidates = pending_;
+        }
+        mask exact;
+        for (std::size_t i = 0; i < traits::size; ++i) {
+            if (candidates[i] && traits::spans[i].size == frames_.size()) {
+                exact.set(i);
+            }
+        }
+        return {exact, candidates & ~exact};
+    }
+
+    bool begin_container(bool is_array) {
+        if (capture_level_ > 0) {
+            ++capture_level_;
+            return true;
+        }
+        if (skip_depth_ > 0) {
+            ++skip_depth_;
+            return true;
+        }
+        auto [exact, deeper] = begin_value();
+        if (exact.any()) {
+            stack_.reset(storage());
+            capture_ = exact | deeper;
+            capture_depth_ = frames_.size();
+            capture_level_ = 1;
+        } else if (deeper.any()) {
+            if (is_array) {
+                auto depth = frames_.size();
+                for_each(deeper, [&](auto i) {
+                    const auto& t = traits::spans[decltype(i)::value].data[depth];
+                    if (t.kind != token_kind::index) {
+                        resolve<decltype(i)::value>(t.kind == token_kind::past_the_end
+                            ? boost::json::error::past_the_end
+                            : boost::json::error::token_not_number);
+                        deeper.reset(decltype(i)::value);
+                    }
+                });
+            }
+            frames_.push_back(frame{deeper, 0, is_array});
+        } else {
+            skip_depth_ = 1;
+        }
+        return true;
+    }
+
+    bool end_container(bool is_array, std::size_t n, boost::json::error_code& ec) {
+        if (capture_level_ > 0) {
+            if (is_array) {
+                stack_.push_array(n);
+            } else {
+                stack_.push_object(n);
+            }
+            if (--capture_level_ == 0) {
+                auto captured = stack_.release();
+                for_each(capture_, [&](auto i) {
+                    constexpr std::size_t I = decltype(i)::value;
+                    const auto& span = traits::spans[I];
+                    boost::json::error_code find_ec;
+                    auto ref = find(captured, span.data + capture_depth_, span.data + span.size, find_ec);
+                    if (ref) {
+                        resolve<I>(*ref);
+                    } else {
+                        resolve<I>(find_ec);
+                    }
+                });
+                return finish(ec);
+            }
+            return true;
+        }
+        if (skip_depth_ > 0) {
+            --skip_depth_;
+            return true;
+        }
+        // the tags still active were not found in this container
+        for_each(frames_.back().active & ~resolved_, [&](auto i) {
+            resolve<decltype(i)::value>(boost::json::error::not_found);
+        });
+        frames_.pop_back();
+        return finish(ec);
+    }
+
+    // make() makes the value, which is called only if a tag needs it, so that the values not
+    // on the paths of the tags are not copied. raw is the string as passed by the parser if
+    // the value is a string.
+    template <class Make>
+    bool scalar(boost::json::error_code& ec, Make&& make, const std::string_view* raw = nullptr) {
+        auto [exact, deeper] = begin_value();
+        std::optional<boost::json::value> jv;
+        for_each(exact, [&](auto i) {
+            constexpr std::size_t I = decltype(i)::value;
+            using type = typename std::tuple_element_t<I, std::tuple<Tags...>>::value_type;
+            if constexpr (std::is_same_v<type, std::string_view>) {
+                if (raw) {
+                    resolve_view<I>(*raw);
+                    return;
+                }
+            }
+            if (!jv) {
+                jv.emplace(make());
+            }
+            resolve<I>(*jv);
+        });
+        for_each(deeper, [&](auto i) {
+            resolve<decltype(i)::value>(boost::json::error::value_is_scalar);
+        });
+        return finish(ec);
+    }
+
+    template <std::size_t I>
+    void resolve(const boost::json::value& jv) {
+        using type = typename std::tuple_element_t<I, std::tuple<Tags...>>::value_type;
+        if constexpr (std::is_same_v<type, std::string_view>) {
+            // the string is on the handler's buffer
+            if (jv.is_string()) {
+                resolve<I>(boost::json::error::not_exact);
+                return;
+            }
+        }
+        if constexpr (owns_storage_v<type>) {
+            std::get<I>(results_) = boost::json::try_value_to<type>(jv);
+        } else {
+            // the result would refer to the handler's buffer, which the next document releases
+            std::get<I>(results_) = boost::json::try_value_to<type>(
+                boost::json::value(jv, boost::json::storage_ptr()));
+        }
+        resolved_.set(I);
+    }
+
+    // refers to the string if the parser passed it from the input text without unescaping.
+    template <std::size_t I>
+    void resolve_view(std::string_view raw) {
+        const auto first = input_.data();
+        const auto last = first + input_.size();
+        if (std::less_equal<>()(first, raw.data()) && std::less_equal<>()(raw.data() + raw.size(), last)) {
+            std::get<I>(results_) = raw;
+            resolved_.set(I);
+        } else {
+            resolve<I>(boost::json::error::not_exact);
+        }
+    }
+
+    template <std::size_t I>
+    void resolve(const boost::json::error_code& ec) {
+        std::get<I>(results_) = ec;
+        resolved_.set(I);
+    }
+
+    // stops the parser once every tag is resolved before the end of the root value. After the
+    // root value, the parser goes on to the end of the document to check the text after it.
+    bool finish(boost::json::error_code& ec) {
+        if (resolved_.all() && capture_level_ == 0 && !frames_.empty()) {
+            finished_ = true;
+            ec = boost::json::error::exception;
+            return false;
+        }
+        return true;
+    }
+
+    unsigned char buffer_[4096];
+    boost::json::monotonic_resource resource_;
+    boost::json::value_stack stack_;
+    std::vector<frame> frames_;
+    std::string key_;
+    std::string chars_;
+    std::string_view input_;
+    mask pending_;
+    mask resolved_;
+    mask capture_;
+    result_type results_ = result_type(boost::json::result<typename Tags::value_type>(
+        boost::json::error_code(boost::json::error::not_found))...);
+    std::size_t skip_depth_ = 0;
+    std::size_t capture_depth_ = 0;
+    std::size_t capture_level_ = 0;
+    bool in_key_ = false;
+    bool in_string_ = false;
+    bool finished_ = false;
+};
+
+// returns the values of the results, or throws the first error in the order of the tags.
+template <class... Tags, std::size_t... Is>
+std::tuple<typename Tags::value_type...> unwrap_results(
+    std::tuple<boost::json::result<typename Tags::value_type>...>&& results, std::index_sequence<Is...>) {
+    boost::json::error_code ec;
+    ((!ec && !std::get<Is>(results) ? (void)(ec = std::get<Is>(results).error()) : void()), ...);
+    if (ec) {
+        throw boost::system::system_error(ec);
+    }
+    return std::tuple<typename Tags::value_type...>(std::move(*std::get<Is>(results))...);
+}
+
+}  // namespace detail
+
+// Extracts the values of the tags from JSON text without building the document.
+//
+// Only the values on the paths of the tags are converted, and parsing stops as soon as
+// every tag is resolved inside the root value, so the text after that point is not
+// validated. Otherwise every tag is an error (extra_data) if the text after the document is
+// not whitespace.
+// An extractor keeps its parser and buffers between calls.
+// The value of a std::string_view tag refers to the text without copying it. It is an error
+// (not_exact) if the string has escapes.
+template <class... Tags>
+class extractor {
+public:
+    using result_type = std::tuple<boost::json::result<typename Tags::value_type>...>;
+    using value_type = std::tuple<typename Tags::value_type...>;
+
+    explicit extractor(const boost::json::parse_options& opt = {})
+        : parser_(opt) {}
+
+    // Tries to extract the values.
+    // Each element of the tuple is the result of the corresponding tag.
+    result_type try_extract(std::string_view text) {
+        auto& handler = parser_.handler();
+        boost::json::error_code ec;
+        parser_.reset();
+        handler.set_input(text);
+        auto n = parser_.write_some(false, text.data(), text.size(), ec);
+        if (handler.finished()) {
+            return std::move(handler.results());
+        }
+        if (!ec && text.find_first_not_of(" \t\n\r", n) != std::string_view::npos) {
+            // the text is not a single document
+            handler.fail_all(boost::json::error::extra_data);
+        } else {
+            handler.fail(ec ? ec : boost::json::error_code(boost::json::error::not_found));
+        }
+        return std::move(handler.results());
+    }
+
+    // Extracts the values.
+    // Throws exception if any error occurs.
+    value_type extract(std::string_view text) {
+        return detail::unwrap_results<Tags...>(try_extract(text), std::index_sequence_for<Tags...>());
+    }
+
+private:
+    boost::json::basic_parser<detail::extract_handler<Tags...>> parser_;
+};
+
+// Tries to extract the values of the tags from JSON text.
+template <class... Tags, class = std::enable_if_t<are_accessor_tags_v<Tags...>>>
+std::tuple<boost::json::result<typename Tags::value_type>...> try_extract(std::string_view text, const Tags&...) {
+    return extractor<Tags...>().try_extract(text);
+}
+
+// Extracts the values of the tags from JSON text.
+// Throws exception if any error occurs.
+template <class... Tags, class = std::enable_if_t<are_accessor_tags_v<Tags...>>>
+std::tuple<typename Tags::value_type...> extract(std::string_view text, const Tags&...) {
+    return extractor<Tags...>().extract(text);
+}
+
+}  // namespace json_access_helper
+
+#endif  // JSON_ACCESS_HELPER_EXTRACT_HPP_
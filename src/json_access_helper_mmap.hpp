@@ -0,0 +1,138 @@
+#ifndef JSON_ACCESS_HELPER_MMAP_HPP_
+#define JSON_ACCESS_HELPER_MMAP_HPP_
+
+#include <cerrno>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <boost/json.hpp>
+
+namespace json_access_helper {
+
+// Hints for the pages of a mapped file. The hints which the system does not support are
+// ignored.
+//
+// sequential: the file is read from the beginning to the end (MADV_SEQUENTIAL), so the pages
+//             are read ahead aggressively and dropped soon after they are read.
+// huge_pages: the mapping may use transparent huge pages (MADV_HUGEPAGE), which reduces the
+//             TLB misses for large files if the file system supports them.
+// populate:   all pages are read when the file is mapped (MAP_POPULATE).
+struct map_options {
+    bool sequential = true;
+    bool huge_pages = true;
+    bool populate = false;
+};
+
+// Read-only memory mapping of a whole file (POSIX).
+//
+// text() refers to the mapping, so the text is passed to the extraction functions without
+// being copied, and std::string_view values extracted from it refer to the file. The
+// mapping must outlive them. The workers of ndjson_extractor read disjoint ranges of it.
+class mapped_file {
+public:
+    mapped_file() noexcept = default;
+
+    // Throws boost::system::system_error if the file cannot be opened or mapped.
+    explicit mapped_file(const std::string& path, const map_options& options = {}) {
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            throw_errno("open");
+        }
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            const int error = errno;
+            ::close(fd);
+            throw_errno("fstat", error);
+        }
+        size_ = static_cast<std::size_t>(st.st_size);
+        if (size_ != 0) {
+            int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+            if (options.populate) {
+                flags |= MAP_POPULATE;
+            }
+#endif
+            void* p = ::mmap(nullptr, size_, PROT_READ, flags, fd, 0);
+            if (p == MAP_FAILED) {
+                const int error = errno;
+                ::close(fd);
+                throw_errno("mmap", error);
+            }
+            data_ = static_cast<const char*>(p);
+            advise(options);
+        }
+        // the mapping is kept after the descriptor is closed
+        ::close(fd);
+    }
+
+    mapped_file(mapped_file&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)) {}
+
+    mapped_file& operator=(mapped_file&& other) noexcept {
+        if (this != &other) {
+            unmap();
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+        }
+        return *this;
+    }
+
+    ~mapped_file() {
+        unmap();
+    }
+
+    const char* data() const noexcept {
+        return data_;
+    }
+
+    std::size_t size() const noexcept {
+        return size_;
+    }
+
+    std::string_view text() const noexcept {
+        return std::string_view(data_ ? data_ : "", size_);
+    }
+
+private:
+    [[noreturn]] static void throw_errno(const char* what, int error = errno) {
+        throw boost::system::system_error(error, boost::system::system_category(), what);
+    }
+
+    void advise(const map_options& options) noexcept {
+        auto p = const_cast<char*>(data_);
+#ifdef MADV_SEQUENTIAL
+        if (options.sequential) {
+            ::madvise(p, size_, MADV_SEQUENTIAL);
+        }
+#endif
+#ifdef MADV_HUGEPAGE
+        if (options.huge_pages) {
+            ::madvise(p, size_, MADV_HUGEPAGE);
+        }
+#endif
+        (void)p;
+        (void)options;
+    }
+
+    void unmap() noexcept {
+        if (data_) {
+            ::munmap(const_cast<char*>(data_), size_);
+        }
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+}  // namespace json_access_helper
+
+#endif  // JSON_ACCESS_HELPER_MMAP_HPP_
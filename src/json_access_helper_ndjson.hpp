@@ -0,0 +1,137 @@
+#ifndef JSON_ACCESS_HELPER_NDJSON_HPP_
+#define JSON_ACCESS_HELPER_NDJSON_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <boost/json.hpp>
+
+#include "json_access_helper.hpp"
+#include "json_access_helper_extract.hpp"
+#include "json_access_helper_pool.hpp"
+
+namespace json_access_helper {
+
+namespace detail {
+
+inline bool is_blank_line(std::string_view line) noexcept {
+    return line.find_first_not_of(" \t\r") == std::string_view::npos;
+}
+
+}  // namespace detail
+
+// Extracts the values of the tags from every line of JSON Lines (NDJSON) text with several
+// threads.
+//
+// The text is split into batches of about batch_bytes at line ends, and the batches of a
+// round (a few per worker) are extracted by a work-stealing pool. Each worker has its own
+// extractor, that is its own parser and memory resource. The results of a round are passed
+// to the callback on the calling thread in input order before the next round starts, so the
+// memory does not grow with the size of the text.
+// Blank lines are skipped. The pool is kept between calls.
+template <class... Tags>
+class ndjson_extractor {
+    static_assert(are_accessor_tags_v<Tags...>, "ndjson_extractor needs accessor tags");
+
+public:
+    using result_type = std::tuple<boost::json::result<typename Tags::value_type>...>;
+    using value_type = std::tuple<typename Tags::value_type...>;
+
+    // threads: the number of threads including the calling one. 0 means
+    //          std::thread::hardware_concurrency().
+    explicit ndjson_extractor(unsigned threads = 0, const boost::json::parse_options& opt = {},
+                              std::size_t batch_bytes = 1 << 20)
+        : pool_(threads != 0 ? threads : std::thread::hardware_concurrency())
+        , batch_bytes_(std::max<std::size_t>(batch_bytes, 1))
+        , batches_(pool_.size() * 4) {
+        extractors_.reserve(pool_.size());
+        for (unsigned w = 0; w < pool_.size(); ++w) {
+            extractors_.push_back(std::make_unique<extractor<Tags...>>(opt));
+        }
+    }
+
+    unsigned threads() const noexcept {
+        return pool_.size();
+    }
+
+    // Tries to extract the values from each line and calls f(line, results) in input order,
+    // where line is the 0-based line number in the text.
+    template <class F>
+    void try_extract(std::string_view text, F&& f) {
+        std::size_t line = 0;
+        while (!text.empty()) {
+            // splits the next round
+            std::size_t count = 0;
+            while (count < batches_.size() && !text.empty()) {
+                auto size = std::min(batch_bytes_, text.size());
+                if (size < text.size()) {
+                    auto eol = std::memchr(text.data() + size - 1, '\n', text.size() - size + 1);
+                    size = eol ? static_cast<const char*>(eol) - text.data() + 1 : text.size();
+                }
+                batches_[count++].text = text.substr(0, size);
+                text.remove_prefix(size);
+            }
+
+            auto job = [this](unsigned worker, std::size_t task) {
+                extract_batch(*extractors_[worker], batches_[task]);
+            };
+            pool_.run(count, job);
+
+            for (std::size_t i = 0; i < count; ++i) {
+                auto& batch = batches_[i];
+                for (auto& [offset, results] : batch.results) {
+                    f(line + offset, std::move(results));
+                }
+                line += batch.lines;
+            }
+        }
+    }
+
+    // Extracts the values from each line and calls f(line, values) in input order.
+    // Throws exception at the first line where any error occurs, after the calls for the
+    // lines before it.
+    template <class F>
+    void extract(std::string_view text, F&& f) {
+        try_extract(text, [&](std::size_t line, result_type&& results) {
+            f(line, detail::unwrap_results<Tags...>(std::move(results), std::index_sequence_for<Tags...>()));
+        });
+    }
+
+private:
+    struct batch {
+        std::string_view text;
+        std::size_t lines = 0;
+        std::vector<std::pair<std::size_t, result_type>> results;
+    };
+
+    static void extract_batch(extractor<Tags...>& ext, batch& b) {
+        b.results.clear();
+        b.lines = 0;
+        auto text = b.text;
+        while (!text.empty()) {
+            auto eol = text.find('\n');
+            auto line = text.substr(0, eol);
+            if (!detail::is_blank_line(line)) {
+                b.results.emplace_back(b.lines, ext.try_extract(line));
+            }
+            ++b.lines;
+            text.remove_prefix(eol == std::string_view::npos ? text.size() : eol + 1);
+        }
+    }
+
+    detail::work_stealing_pool pool_;
+    std::size_t batch_bytes_;
+    std::vector<batch> batches_;
+    std::vector<std::unique_ptr<extractor<Tags...>>> extractors_;
+};
+
+}  // namespace json_access_helper
+
+#endif  // JSON_ACCESS_HELPER_NDJSON_HPP_
@@ -0,0 +1,180 @@
+#ifndef JSON_ACCESS_HELPER_PARAM_HPP_
+#define JSON_ACCESS_HELPER_PARAM_HPP_
+
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include <boost/json.hpp>
+
+#include "json_access_helper.hpp"
+
+namespace json_access_helper {
+
+namespace detail {
+
+// "{}" is a placeholder in the pointer of a parameterized accessor.
+constexpr bool is_placeholder(const token& t) {
+    return t.kind == token_kind::key && t.key == "{}";
+}
+
+template <class Tag>
+struct param_traits {
+    static constexpr std::size_t count = [] {
+        std::size_t n = 0;
+        for (const auto& t : pointer_traits<Tag>::tokens) {
+            n += is_placeholder(t) ? 1 : 0;
+        }
+        return n;
+    }();
+
+    // token positions of the placeholders
+    static constexpr std::array<std::size_t, count> positions = [] {
+        std::array<std::size_t, count> positions = {};
+        std::size_t n = 0;
+        for (std::size_t i = 0; i < pointer_traits<Tag>::size; ++i) {
+            if (is_placeholder(pointer_traits<Tag>::tokens[i])) {
+                positions[n++] = i;
+            }
+        }
+        return positions;
+    }();
+};
+
+}  // namespace detail
+
+// Pointer of a parameterized accessor whose placeholders are replaced by the arguments.
+//
+// The fixed tokens are copied from the tokenized pointer, and only the placeholders are
+// made from the arguments. An integer argument is an array index (or the key of its decimal
+// text in an object), and a string argument is a key, an array index or "-" as in a JSON
+// Pointer without escapes. Nothing is allocated.
+// The string arguments must outlive the object, which is usually a temporary in the call.
+template <class Tag>
+class param_path {
+public:
+    using tag_type = Tag;
+    using value_type = typename Tag::value_type;
+
+    template <class... Args>
+    explicit param_path(const Args&... args) noexcept : tokens_(pointer_traits<Tag>::tokens) {
+        static_assert(sizeof...(Args) == detail::param_traits<Tag>::count,
+                      "the number of arguments must be the number of placeholders");
+        set_args(std::index_sequence_for<Args...>(), args...);
+    }
+
+    param_path(const param_path&) = delete;
+    param_path& operator=(const param_path&) = delete;
+
+    const token* begin() const noexcept {
+        return tokens_.data();
+    }
+
+    const token* end() const noexcept {
+        return tokens_.data() + tokens_.size();
+    }
+
+private:
+    template <std::size_t... Is, class... Args>
+    void set_args(std::index_sequence<Is...>, const Args&... args) noexcept {
+        (set_arg(Is, args), ...);
+    }
+
+    template <class T>
+    void set_arg(std::size_t i, const T& arg) noexcept {
+        auto& t = tokens_[detail::param_traits<Tag>::positions[i]];
+        if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>) {
+            auto& buffer = numbers_[i];
+            auto last = std::to_chars(buffer.data(), buffer.data() + buffer.size(), arg).ptr;
+            const auto key = std::string_view(buffer.data(), last - buffer.data());
+            // a negative number is a key, and the others are indexes
+            t = detail::make_token(key);
+        } else {
+            static_assert(std::is_convertible_v<const T&, std::string_view>,
+                          "an argument must be an integer or a string");
+            t = detail::make_token(std::string_view(arg));
+        }
+    }
+
+    std::array<token, pointer_traits<Tag>::size> tokens_;
+    std::array<std::array<char, 24>, detail::param_traits<Tag>::count> numbers_;
+};
+
+// Reads the value of the parameterized accessor.
+// Throws exception if any error occurs.
+template <class Tag>
+typename Tag::value_type read(const boost::json::value& jv, const param_path<Tag>& path) {
+    boost::json::error_code ec;
+    auto ref = detail::find(jv, path.begin(), path.end(), ec);
+    if (!ref) {
+        throw boost::system::system_error(ec);
+    }
+    return boost::json::value_to<typename Tag::value_type>(*ref);
+}
+
+// Tries to read the value of the parameterized accessor.
+template <class Tag>
+boost::json::result<typename Tag::value_type> try_read(const boost::json::value& jv, const param_path<Tag>& path) {
+    boost::json::error_code ec;
+    auto ref = detail::find(jv, path.begin(), path.end(), ec);
+    if (!ref) {
+        return ec;
+    }
+    return boost::json::try_value_to<typename Tag::value_type>(*ref);
+}
+
+// Writes the value of the parameterized accessor, reusing the storage of the existing value.
+// Returns false if the value does not exist.
+template <class Tag>
+bool write(boost::json::value& jv, const param_path<Tag>& path, const typename Tag::value_type& value) {
+    boost::json::error_code ec;
+    auto ref = detail::find(jv, path.begin(), path.end(), ec);
+    if (!ref) {
+        return false;
+    }
+    detail::store(*ref, value);
+    return true;
+}
+
+// Writes the value of the parameterized accessor, creating the missing objects and arrays.
+template <class Tag>
+boost::json::value& emplace(boost::json::value& jv, const param_path<Tag>& path,
+                            const typename Tag::value_type& value) {
+    return detail::emplace(jv, path.begin(), path.end(), [&](boost::json::value& ref) {
+        detail::store(ref, value);
+    });
+}
+
+// Returns the value of the parameterized accessor, or nullptr if it does not exist.
+template <class Tag>
+boost::json::value* reference(boost::json::value& jv, const param_path<Tag>& path) {
+    boost::json::error_code ec;
+    return detail::find(jv, path.begin(), path.end(), ec);
+}
+
+template <class Tag>
+const boost::json::value* reference(const boost::json::value& jv, const param_path<Tag>& path) {
+    boost::json::error_code ec;
+    return detail::find(jv, path.begin(), path.end(), ec);
+}
+
+}  // namespace json_access_helper
+
+// Defines a parameterized accessor whose pointer has "{}" placeholders, e.g.
+// "/users/{}/name". Tag(args...) makes the pointer for the functions above.
+#define DEFINE_JSON_PARAM_ACCESSOR(Tag, Type, Key)                                          \
+    struct Tag##T {                                                                         \
+        using value_type = Type;                                                            \
+        static constexpr std::string_view json_pointer = Key;                               \
+                                                                                            \
+        template <class... Args>                                                            \
+        ::json_access_helper::param_path<Tag##T> operator()(const Args&... args) const {    \
+            return ::json_access_helper::param_path<Tag##T>(args...);                       \
+        }                                                                                   \
+    };                                                                                      \
+    inline constexpr Tag##T Tag = {};
+
+#endif  // JSON_ACCESS_HELPER_PARAM_HPP_
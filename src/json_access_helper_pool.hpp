@@ -0,0 +1,205 @@
+#ifndef JSON_ACCESS_HELPER_POOL_HPP_
+#define JSON_ACCESS_HELPER_POOL_HPP_
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace json_access_helper {
+
+namespace detail {
+
+// Deque of task indices. The owner pops from the back, and the other workers steal from the
+// front.
+class task_deque {
+public:
+    void push(std::size_t task) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.push_back(task);
+    }
+
+    bool pop(std::size_t& task) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (tasks_.empty()) {
+            return false;
+        }
+        task = tasks_.back();
+        tasks_.pop_back();
+        return true;
+    }
+
+    bool steal(std::size_t& task) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (tasks_.empty()) {
+            return false;
+        }
+        task = tasks_.front();
+        tasks_.pop_front();
+        return true;
+    }
+
+private:
+    std::mutex mutex_;
+    std::deque<std::size_t> tasks_;
+};
+
+// Fixed set of threads running rounds of indexed tasks with work stealing.
+//
+// run() gives each worker a contiguous block of the tasks. A worker whose deque is empty
+// steals from the others. The calling thread is worker 0, so a pool of one worker starts
+// no thread.
+class work_stealing_pool {
+public:
+    explicit work_stealing_pool(unsigned workers)
+        : deques_(std::max(1u, workers)) {
+        try {
+            threads_.reserve(deques_.size() - 1);
+            for (unsigned w = 1; w < deques_.size(); ++w) {
+                threads_.emplace_back([this, w] { loop(w); });
+            }
+        } catch (...) {
+            // the destructor does not run, and a joinable thread must not be destroyed
+            stop();
+            throw;
+        }
+    }
+
+    work_stealing_pool(const work_stealing_pool&) = delete;
+    work_stealing_pool& operator=(const work_stealing_pool&) = delete;
+
+    ~work_stealing_pool() {
+        stop();
+    }
+
+    unsigned size() const noexcept {
+        return static_cast<unsigned>(deques_.size());
+    }
+
+    // Calls f(worker, task) for each task in [0, n) and returns when all of them are done.
+    // Rethrows the first exception thrown by f.
+    template <class F>
+    void run(std::size_t n, F& f) {
+        const auto workers = deques_.size();
+        for (std::size_t w = 0; w < workers; ++w) {
+            // pushed in reverse so that the owner pops its block from the front
+            for (auto task = n * (w + 1) / workers; task-- > n * w / workers;) {
+                deques_[w].push(task);
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            job_ = &f;
+            call_ = [](void* job, unsigned worker, std::size_t task) {
+                (*static_cast<F*>(job))(worker, task);
+            };
+            error_ = nullptr;
+            active_ = static_cast<unsigned>(threads_.size());
+            ++generation_;
+        }
+        start_.notify_all();
+        work(0);
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this] { return active_ == 0; });
+        if (error_) {
+            std::rethrow_exception(std::exchange(error_, nullptr));
+        }
+    }
+
+private:
+    void stop() noexcept {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        start_.notify_all();
+        for (auto& thread : threads_) {
+            thread.join();
+        }
+    }
+
+    void loop(unsigned worker) {
+        std::size_t seen = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                start_.wait(lock, [&] { return stop_ || generation_ != seen; });
+                if (stop_) {
+                    return;
+                }
+                seen = generation_;
+            }
+            work(worker);
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (--active_ == 0) {
+                    done_.notify_one();
+                }
+            }
+        }
+    }
+
+    // runs the tasks until every deque is empty. No task is pushed during a round.
+    void work(unsigned worker) {
+        std::size_t task;
+        while (next(worker, task)) {
+            try {
+                call_(job_, worker, task);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!error_) {
+                    error_ = std::current_exception();
+                }
+            }
+        }
+    }
+
+    bool next(unsigned worker, std::size_t& task) {
+        if (deques_[worker].pop(task)) {
+            return true;
+        }
+        for (std::size_t i = 1; i < deques_.size(); ++i) {
+            if (deques_[(worker + i) % deques_.size()].steal(task)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::vector<task_deque> deques_;
+    std::vector<std::thread> threads_;
+    std::mutex mutex_;
+    std::condition_variable start_;
+    std::condition_variable done_;
+    void* job_ = nullptr;
+    void (*call_)(void*, unsigned, std::size_t) = nullptr;
+    std::exception_ptr error_;
+    std::size_t generation_ = 0;
+    unsigned active_ = 0;
+    bool stop_ = false;
+};
+
+// Pool of std::thread::hardware_concurrency() workers shared by the parallel reads. It is
+// started by the first of them and kept until the program exits.
+// run() is not reentrant, so a caller must hold shared_pool_mutex() while it uses the pool.
+inline work_stealing_pool& shared_pool() {
+    static work_stealing_pool pool(std::thread::hardware_concurrency());
+    return pool;
+}
+
+inline std::mutex& shared_pool_mutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+}  // namespace detail
+
+}  // namespace json_access_helper
+
+#endif  // JSON_ACCESS_HELPER_POOL_HPP_
@@ -0,0 +1,438 @@
+#ifndef JSON_ACCESS_HELPER_SERIALIZE_HPP_
+#define JSON_ACCESS_HELPER_SERIALIZE_HPP_
+
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <map>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <boost/json.hpp>
+
+#include "json_access_helper.hpp"
+
+namespace json_access_helper {
+
+namespace detail {
+
+// error in the layout of the pointers given to serializer
+enum class layout_error {
+    none,
+    prefix,        // a pointer is equal to or a prefix of another one
+    key_in_array,  // an object key is given where an array is created by another pointer
+    index_gap,     // array indices are not consecutive from 0
+};
+
+constexpr char hex_digit(unsigned n) {
+    return "0123456789abcdef"[n & 0xf];
+}
+
+// returns the escape sequence of a character as a JSON string, or nullptr if it is written as is.
+constexpr const char* escape_sequence(char c) {
+    switch (c) {
+    case '"':  return "\\\"";
+    case '\\': return "\\\\";
+    case '\b': return "\\b";
+    case '\f': return "\\f";
+    case '\n': return "\\n";
+    case '\r': return "\\r";
+    case '\t': return "\\t";
+    default:   return nullptr;
+    }
+}
+
+constexpr bool needs_escape(char c) {
+    return c == '"' || c == '\\' || static_cast<unsigned char>(c) < 0x20;
+}
+
+// JSON text written around the values, split into a segment before each value and one
+// after the last value. The segments are stored in one buffer.
+template <std::size_t N, std::size_t Capacity>
+struct segment_table {
+    std::array<char, Capacity> chars = {};
+    std::array<std::size_t, N + 2> offsets = {};
+    layout_error error = layout_error::none;
+
+    constexpr std::string_view segment(std::size_t i) const {
+        return std::string_view(chars.data() + offsets[i], offsets[i + 1] - offsets[i]);
+    }
+};
+
+template <std::size_t Capacity>
+struct segment_writer {
+    std::array<char, Capacity>& chars;
+    std::size_t size = 0;
+
+    constexpr void put(char c) {
+        chars[size++] = c;
+    }
+
+    constexpr void put_key(std::string_view key) {
+        put('"');
+        for (char c : key) {
+            if (auto escaped = escape_sequence(c)) {
+                for (; *escaped; ++escaped) {
+                    put(*escaped);
+                }
+            } else if (needs_escape(c)) {
+                put('\\');
+                put('u');
+                put('0');
+                put('0');
+                put(hex_digit(static_cast<unsigned char>(c) >> 4));
+                put(hex_digit(static_cast<unsigned char>(c)));
+            } else {
+                put(c);
+            }
+        }
+        put('"');
+        put(':');
+    }
+};
+
+// builds the segments of the pointers visited in the order of the traversal plan.
+// A container is an array if the token of its first value is an array index or "-", as
+// emplace does for a null value.
+template <std::size_t Capacity, std::size_t MaxDepth, std::size_t N>
+constexpr segment_table<N, Capacity> make_segment_table(const std::array<token_span, N>& spans,
+                                                        const traversal_plan<N>& plan) {
+    segment_table<N, Capacity> table;
+    segment_writer<Capacity> out{table.chars};
+    std::array<bool, MaxDepth + 1> is_array = {};
+    std::array<std::size_t, MaxDepth + 1> count = {};
+    token_span prev = {nullptr, 0};
+    for (std::size_t i = 0; i < N; ++i) {
+        table.offsets[i] = out.size;
+        const auto& span = spans[plan.order[i]];
+        std::size_t depth = 0;
+        if (i > 0) {
+            depth = plan.shared[i];
+            // "-" appends a new element for each pointer
+            for (std::size_t k = 0; k < depth; ++k) {
+                if (span.data[k].kind == token_kind::past_the_end) {
+                    depth = k;
+                    break;
+                }
+            }
+            if (depth >= span.size || depth >= prev.size) {
+                table.error = layout_error::prefix;
+                return table;
+            }
+            for (std::size_t d = prev.size - 1; d > depth; --d) {
+                out.put(is_array[d] ? ']' : '}');
+            }
+            out.put(',');
+        }
+        for (std::size_t d = depth; d < span.size; ++d) {
+            const auto& t = span.data[d];
+            if (i == 0 || d > depth) {
+                is_array[d] = t.kind != token_kind::key;
+                count[d] = 0;
+                out.put(is_array[d] ? '[' : '{');
+            }
+            if (!is_array[d]) {
+                out.put_key(t.key);
+            } else if (t.kind == token_kind::key) {
+                table.error = layout_error::key_in_array;
+                return table;
+            } else if (t.kind == token_kind::index && t.index != count[d]) {
+                table.error = layout_error::index_gap;
+                return table;
+            } else {
+                ++count[d];
+            }
+        }
+        prev = span;
+    }
+    table.offsets[N] = out.size;
+    for (std::size_t d = prev.size; d > 0; --d) {
+        out.put(is_array[d - 1] ? ']' : '}');
+    }
+    table.offsets[N + 1] = out.size;
+    return table;
+}
+
+template <class... Tags>
+struct serializer_traits {
+    using traits = multi_pointer_traits<Tags...>;
+
+    // each token is written at most once with 6 bytes per character, 2 quotes, ':' and
+    // '{' or '[', and each value adds ',' and closes at most max_depth containers.
+    static constexpr std::size_t capacity =
+        ((pointer_traits<Tags>::chars.size() * 6 + pointer_traits<Tags>::size * 4 + 1) + ...)
+        + traits::plan.max_depth * sizeof...(Tags) + 1;
+
+    static constexpr auto table =
+        make_segment_table<capacity, traits::plan.max_depth>(traits::spans, traits::plan);
+    static_assert(table.error != layout_error::prefix,
+                  "a pointer must not be equal to or a prefix of another pointer");
+    static_assert(table.error != layout_error::key_in_array,
+                  "an object key must not be mixed with array indices in the same container");
+    static_assert(table.error != layout_error::index_gap,
+                  "array indices must be consecutive from 0");
+};
+
+// writes into a caller buffer, and counts the size of the whole text even if it overflows.
+class buffer_sink {
+public:
+    buffer_sink(char* dest, std::size_t size) noexcept : dest_(dest), capacity_(size) {}
+
+    void append(const char* data, std::size_t size) noexcept {
+        if (size != 0 && size_ + size <= capacity_) {
+            std::memcpy(dest_ + size_, data, size);
+        }
+        size_ += size;
+    }
+
+    void put(char c) noexcept {
+        if (size_ < capacity_) {
+            dest_[size_] = c;
+        }
+        ++size_;
+    }
+
+    std::size_t size() const noexcept {
+        return size_;
+    }
+
+private:
+    char* dest_;
+    std::size_t capacity_;
+    std::size_t size_ = 0;
+};
+
+// appends to a string.
+class string_sink {
+public:
+    explicit string_sink(std::string& out) noexcept : out_(out) {}
+
+    void append(const char* data, std::size_t size) {
+        out_.append(data, size);
+    }
+
+    void put(char c) {
+        out_.push_back(c);
+    }
+
+private:
+    std::string& out_;
+};
+
+template <class Sink>
+void write_string(Sink& sink, std::string_view s) {
+    sink.put('"');
+    std::size_t run = 0;  // start of the characters not written yet
+    for (std::size_t i = 0; i < s.size(); ++i) {
+        if (!needs_escape(s[i])) {
+            continue;
+        }
+        sink.append(s.data() + run, i - run);
+        run = i + 1;
+        if (auto escaped = escape_sequence(s[i])) {
+            sink.append(escaped, 2);
+        } else {
+            const char u[] = {'\\', 'u', '0', '0',
+                              hex_digit(static_cast<unsigned char>(s[i]) >> 4),
+                              hex_digit(static_cast<unsigned char>(s[i]))};
+            sink.append(u, sizeof(u));
+        }
+    }
+    sink.append(s.data() + run, s.size() - run);
+    sink.put('"');
+}
+
+// same text as boost::json::serialize for a finite number, except that the shortest
+// representation of std::to_chars is used. ".0" keeps an integral double a double.
+// Without std::to_chars for floating point types, the text of boost::json::serialize is used
+// (e.g. "2E0").
+template <class Sink, class T>
+void write_number(Sink& sink, T v) {
+    if constexpr (std::is_floating_point_v<T>) {
+        if (std::isnan(v)) {
+            sink.append("null", 4);
+            return;
+        }
+        if (std::isinf(v)) {
+            v < 0 ? sink.append("-1e99999", 8) : sink.append("1e99999", 7);
+            return;
+        }
+    }
+    if constexpr (std::is_integral_v<T> || has_floating_charconv) {
+        char buf[32];
+        auto last = std::to_chars(buf, buf + sizeof(buf), v).ptr;
+        const std::string_view text(buf, static_cast<std::size_t>(last - buf));
+        sink.append(text.data(), text.size());
+        if constexpr (std::is_floating_point_v<T>) {
+            if (text.find_first_of(".eE") == std::string_view::npos) {
+                sink.append(".0", 2);
+            }
+        }
+    } else {
+        const auto text = boost::json::serialize(boost::json::value(static_cast<double>(v)));
+        sink.append(text.data(), text.size());
+        if (text.find_first_of(".eE") == std::string::npos) {
+            sink.append(".0", 2);
+        }
+    }
+}
+
+template <class Sink, class T>
+void write_value(Sink& sink, const T& v);
+
+template <class Sink, class T, class Allocator>
+void write_value(Sink& sink, const std::vector<T, Allocator>& v);
+
+template <class Sink, class Allocator>
+void write_value(Sink& sink, const std::vector<bool, Allocator>& v);
+
+template <class Sink, class Traits, class KeyAllocator, class T, class Compare, class Allocator>
+void write_value(
+    Sink& sink,
+    const std::map<std::basic_string<char, Traits, KeyAllocator>, T, Compare, Allocator>& v);
+
+template <class Sink, class Traits, class KeyAllocator, class T, class Hash, class KeyEqual, class Allocator>
+void write_value(
+    Sink& sink,
+    const std::unordered_map<std::basic_string<char, Traits, KeyAllocator>, T, Hash, KeyEqual, Allocator>& v);
+
+template <class Sink, class Map>
+void write_map(Sink& sink, const Map& v) {
+    sink.put('{');
+    bool first = true;
+    for (const auto& kv : v) {
+        if (!first) {
+            sink.put(',');
+        }
+        first = false;
+        write_string(sink, kv.first);
+        sink.put(':');
+        write_value(sink, kv.second);
+    }
+    sink.put('}');
+}
+
+// writes the value directly for the types converted by value_from without a custom
+// conversion, and through value_from and boost::json::serialize for the others.
+template <class Sink, class T>
+void write_value(Sink& sink, const T& v) {
+    if constexpr (std::is_same_v<T, bool>) {
+        v ? sink.append("true", 4) : sink.append("false", 5);
+    } else if constexpr (std::is_same_v<T, std::nullptr_t>) {
+        sink.append("null", 4);
+    } else if constexpr (std::is_arithmetic_v<T>) {
+        write_number(sink, v);
+    } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+        write_string(sink, std::string_view(v));
+    } else if constexpr (std::is_same_v<T, boost::json::string>) {
+        write_string(sink, std::string_view(v.data(), v.size()));
+    } else {
+        const auto text = boost::json::serialize(boost::json::value_from(v));
+        sink.append(text.data(), text.size());
+    }
+}
+
+template <class Sink, class T, class Allocator>
+void write_value(Sink& sink, const std::vector<T, Allocator>& v) {
+    sink.put('[');
+    for (std::size_t i = 0; i < v.size(); ++i) {
+        if (i > 0) {
+            sink.put(',');
+        }
+        write_value(sink, v[i]);
+    }
+    sink.put(']');
+}
+
+template <class Sink, class Allocator>
+void write_value(Sink& sink, const std::vector<bool, Allocator>& v) {
+    sink.put('[');
+    for (std::size_t i = 0; i < v.size(); ++i) {
+        if (i > 0) {
+            sink.put(',');
+        }
+        write_value(sink, static_cast<bool>(v[i]));
+    }
+    sink.put(']');
+}
+
+template <class Sink, class Traits, class KeyAllocator, class T, class Compare, class Allocator>
+void write_value(
+    Sink& sink,
+    const std::map<std::basic_string<char, Traits, KeyAllocator>, T, Compare, Allocator>& v) {
+    write_map(sink, v);
+}
+
+template <class Sink, class Traits, class KeyAllocator, class T, class Hash, class KeyEqual, class Allocator>
+void write_value(
+    Sink& sink,
+    const std::unordered_map<std::basic_string<char, Traits, KeyAllocator>, T, Hash, KeyEqual, Allocator>& v) {
+    write_map(sink, v);
+}
+
+}  // namespace detail
+
+// Writes the values of the tags as JSON text without building a DOM.
+//
+// The objects and arrays on the pointers, the keys and their escapes are laid out at
+// compile time, so only the values are written at run time. The members are written in the
+// order of the pointers, as the tags are visited by read with several tags. The text is
+// equal to emplacing the values into a null value and serializing it, except for the order
+// of the members and the representation of floating point numbers.
+template <class... Tags>
+class serializer {
+    static_assert(sizeof...(Tags) > 0, "serializer needs at least one tag");
+    static_assert(are_accessor_tags_v<Tags...>, "serializer needs accessor tags");
+
+public:
+    // Writes the text into [dest, dest + size) and returns the size of the whole text.
+    // The text is complete only if the returned size is not greater than size, like
+    // snprintf. It is not null-terminated.
+    std::size_t write(char* dest, std::size_t size, const typename Tags::value_type&... values) const {
+        detail::buffer_sink sink(dest, size);
+        write_all(sink, std::forward_as_tuple(values...), std::index_sequence_for<Tags...>());
+        return sink.size();
+    }
+
+    // Appends the text to out.
+    void write(std::string& out, const typename Tags::value_type&... values) const {
+        detail::string_sink sink(out);
+        write_all(sink, std::forward_as_tuple(values...), std::index_sequence_for<Tags...>());
+    }
+
+    // Returns the text.
+    std::string write(const typename Tags::value_type&... values) const {
+        std::string out;
+        write(out, values...);
+        return out;
+    }
+
+private:
+    using traits = detail::serializer_traits<Tags...>;
+
+    template <class Sink, class Values, std::size_t... Is>
+    static void write_all(Sink& sink, const Values& values, std::index_sequence<Is...>) {
+        constexpr const auto& order = traits::traits::plan.order;
+        ((write_segment<Is>(sink), detail::write_value(sink, std::get<order[Is]>(values))), ...);
+        write_segment<sizeof...(Tags)>(sink);
+    }
+
+    template <std::size_t I, class Sink>
+    static void write_segment(Sink& sink) {
+        constexpr auto segment = traits::table.segment(I);
+        if constexpr (!segment.empty()) {
+            sink.append(segment.data(), segment.size());
+        }
+    }
+};
+
+}  // namespace json_access_helper
+
+#endif  // JSON_ACCESS_HELPER_SERIALIZE_HPP_
@@ -0,0 +1,842 @@
+#ifndef JSON_ACCESS_HELPER_TEXT_HPP_
+#define JSON_ACCESS_HELPER_TEXT_HPP_
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <boost/json.hpp>
+
+#include "json_access_helper.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define JSON_ACCESS_HELPER_HAS_SSE2_ 1
+#include <emmintrin.h>
+#if defined(__GNUC__)
+// AVX2 code is compiled with the target attribute and selected at run time.
+#define JSON_ACCESS_HELPER_HAS_AVX2_ 1
+#include <immintrin.h>
+#endif
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#if defined(__GNUC__)
+#define JSON_ACCESS_HELPER_ALWAYS_INLINE_ __attribute__((always_inline))
+#else
+#define JSON_ACCESS_HELPER_ALWAYS_INLINE_
+#endif
+
+namespace json_access_helper {
+
+namespace detail {
+
+inline const char* skip_whitespace(const char* p, const char* end) noexcept {
+    while (p != end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')) {
+        ++p;
+    }
+    return p;
+}
+
+// skips the string which begins at p and returns the position after the closing quote.
+inline const char* skip_string(const char* p, const char* end, boost::json::error_code& ec) noexcept {
+    for (++p; p != end; ++p) {
+        if (*p == '"') {
+            return p + 1;
+        }
+        if (*p == '\\' && ++p == end) {
+            break;
+        }
+    }
+    ec = boost::json::error::incomplete;
+    return nullptr;
+}
+
+// skips the value which begins at p by matching brackets and quotes.
+// The skipped text is not validated.
+inline const char* skip_value(const char* p, const char* end, boost::json::error_code& ec) noexcept {
+    if (p == end) {
+        ec = boost::json::error::incomplete;
+        return nullptr;
+    }
+    if (*p == '"') {
+        return skip_string(p, end, ec);
+    }
+    if (*p != '{' && *p != '[') {
+        while (p != end && *p != ',' && *p != '}' && *p != ']'
+               && *p != ' ' && *p != '\t' && *p != '\n' && *p != '\r') {
+            ++p;
+        }
+        return p;
+    }
+    std::size_t depth = 0;
+    while (p != end) {
+        switch (*p) {
+        case '"':
+            p = skip_string(p, end, ec);
+            if (!p) {
+                return nullptr;
+            }
+            continue;
+        case '{':
+        case '[':
+            ++depth;
+            break;
+        case '}':
+        case ']':
+            if (--depth == 0) {
+                return p + 1;
+            }
+            break;
+        default:
+            break;
+        }
+        ++p;
+    }
+    ec = boost::json::error::incomplete;
+    return nullptr;
+}
+
+// compares the quoted key text with the decoded token key.
+inline bool key_text_equals(std::string_view quoted, std::string_view key, boost::json::error_code& ec) {
+    auto raw = quoted.substr(1, quoted.size() - 2);
+    if (raw.find('\\') == std::string_view::npos) {
+        return raw == key;
+    }
+    // rare case: decodes the escaped key with the parser
+    auto decoded = boost::json::parse(boost::json::string_view(quoted.data(), quoted.size()), ec);
+    return !ec && std::string_view(decoded.get_string()) == key;
+}
+
+// compares the key which begins at the opening quote p with the decoded token key, and
+// returns the position after the closing quote.
+inline const char* match_key(const char* p, const char* end, std::string_view key, bool& matched,
+                             boost::json::error_code& ec) {
+    auto last = skip_string(p, end, ec);
+    if (!last) {
+        return nullptr;
+    }
+    matched = key_text_equals(std::string_view(p, static_cast<std::size_t>(last - p)), key, ec);
+    return ec ? nullptr : last;
+}
+
+// finds the text of the value referred to by the tokens without tokenizing the other values.
+inline std::string_view find_text(std::string_view text, const token* first, const token* last,
+                                  boost::json::error_code& ec) {
+    const char* end = text.data() + text.size();
+    const char* p = skip_whitespace(text.data(), end);
+    for (auto it = first; it != last; ++it) {
+        if (p == end) {
+            ec = boost::json::error::incomplete;
+            return {};
+        }
+        if (*p == '{') {
+            p = skip_whitespace(p + 1, end);
+            if (p != end && *p == '}') {
+                ec = boost::json::error::not_found;
+                return {};
+            }
+            while (true) {
+                if (p == end || *p != '"') {
+                    ec = p == end ? boost::json::error::incomplete : boost::json::error::syntax;
+                    return {};
+                }
+                bool matched = false;
+                p = match_key(p, end, it->key, matched, ec);
+                if (!p) {
+                    return {};
+                }
+                p = skip_whitespace(p, end);
+                if (p == end || *p != ':') {
+                    ec = p == end ? boost::json::error::incomplete : boost::json::error::syntax;
+                    return {};
+                }
+                p = skip_whitespace(p + 1, end);
+                if (matched) {
+                    break;
+                }
+                p = skip_value(p, end, ec);
+                if (!p) {
+                    return {};
+                }
+                p = skip_whitespace(p, end);
+                if (p != end && *p == ',') {
+                    p = skip_whitespace(p + 1, end);
+                    continue;
+                }
+                ec = p == end ? boost::json::error::incomplete
+                   : *p == '}' ? boost::json::error::not_found
+                   : boost::json::error::syntax;
+                return {};
+            }
+        } else if (*p == '[') {
+            if (it->kind != token_kind::index) {
+                ec = it->kind == token_kind::past_the_end
+                    ? boost::json::error::past_the_end
+                    : boost::json::error::token_not_number;
+                return {};
+            }
+            p = skip_whitespace(p + 1, end);
+            if (p != end && *p == ']') {
+                ec = boost::json::error::not_found;
+                return {};
+            }
+            for (std::size_t i = 0; i < it->index; ++i) {
+                p = skip_value(p, end, ec);
+                if (!p) {
+                    return {};
+                }
+                p = skip_whitespace(p, end);
+                if (p == end || *p != ',') {
+                    ec = p == end ? boost::json::error::incomplete
+                       : *p == ']' ? boost::json::error::not_found
+                       : boost::json::error::syntax;
+                    return {};
+                }
+                p = skip_whitespace(p + 1, end);
+            }
+        } else {
+            ec = boost::json::error::value_is_scalar;
+            return {};
+        }
+    }
+    auto value_end = skip_value(p, end, ec);
+    if (!value_end) {
+        return {};
+    }
+    return std::string_view(p, static_cast<std::size_t>(value_end - p));
+}
+
+// masks of one 64-byte block. Bit i corresponds to the i-th byte.
+struct block_masks {
+    std::uint64_t quote;
+    std::uint64_t backslash;
+    std::uint64_t open;       // { [
+    std::uint64_t close;      // } ]
+    std::uint64_t separator;  // : ,
+};
+
+inline block_masks classify_scalar(const char* p) noexcept {
+    block_masks masks{};
+    for (unsigned i = 0; i < 64; ++i) {
+        const auto bit = std::uint64_t(1) << i;
+        switch (p[i]) {
+        case '"':
+            masks.quote |= bit;
+            break;
+        case '\\':
+            masks.backslash |= bit;
+            break;
+        case '{':
+        case '[':
+            masks.open |= bit;
+            break;
+        case '}':
+        case ']':
+            masks.close |= bit;
+            break;
+        case ':':
+        case ',':
+            masks.separator |= bit;
+            break;
+        default:
+            break;
+        }
+    }
+    return masks;
+}
+
+#if JSON_ACCESS_HELPER_HAS_SSE2_
+inline std::uint64_t movemask_sse2(__m128i chunk, char c, unsigned shift) noexcept {
+    const auto mask = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(c)));
+    return static_cast<std::uint64_t>(static_cast<unsigned>(mask)) << shift;
+}
+
+inline block_masks classify_sse2(const char* p) noexcept {
+    block_masks masks{};
+    for (unsigned i = 0; i < 64; i += 16) {
+        const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        // '[' and ']' differ from '{' and '}' only in the bit 0x20
+        const auto folded = _mm_or_si128(chunk, _mm_set1_epi8(0x20));
+        masks.quote |= movemask_sse2(chunk, '"', i);
+        masks.backslash |= movemask_sse2(chunk, '\\', i);
+        masks.open |= movemask_sse2(folded, '{', i);
+        masks.close |= movemask_sse2(folded, '}', i);
+        masks.separator |= movemask_sse2(chunk, ':', i) | movemask_sse2(chunk, ',', i);
+    }
+    return masks;
+}
+#endif
+
+#if JSON_ACCESS_HELPER_HAS_AVX2_
+__attribute__((target("avx2")))
+inline std::uint64_t movemask_avx2(__m256i chunk, char c, unsigned shift) noexcept {
+    const auto mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(c)));
+    return static_cast<std::uint64_t>(static_cast<unsigned>(mask)) << shift;
+}
+
+__attribute__((target("avx2"))) inline block_masks classify_avx2(const char* p) noexcept {
+    block_masks masks{};
+    for (unsigned i = 0; i < 64; i += 32) {
+        const auto chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        const auto folded = _mm256_or_si256(chunk, _mm256_set1_epi8(0x20));
+        masks.quote |= movemask_avx2(chunk, '"', i);
+        masks.backslash |= movemask_avx2(chunk, '\\', i);
+        masks.open |= movemask_avx2(folded, '{', i);
+        masks.close |= movemask_avx2(folded, '}', i);
+        masks.separator |= movemask_avx2(chunk, ':', i) | movemask_avx2(chunk, ',', i);
+    }
+    return masks;
+}
+#endif
+
+// bits of one 64-byte block in structural_index.
+struct index_word {
+    std::uint64_t structural;  // unescaped quotes and { } [ ] : , outside strings
+    std::uint64_t open;        // { [ outside strings
+    std::uint64_t close;       // } ] outside strings
+};
+
+// carries the escape and string states over the block boundary.
+struct index_state {
+    std::uint64_t escaped = 0;    // bit 0 is set if the first byte of the next block is escaped
+    std::uint64_t in_string = 0;  // all bits are set if the next block begins in a string
+};
+
+// sets bit i if the number of bits at or below i is odd.
+inline std::uint64_t prefix_xor(std::uint64_t x) noexcept {
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+}
+
+inline index_word make_index_word(const block_masks& masks, index_state& state) noexcept {
+    auto escaped = state.escaped;
+    state.escaped = 0;
+    // backslashes are rare, so they are visited one by one
+    for (auto backslash = masks.backslash; backslash != 0; backslash &= backslash - 1) {
+        const auto bit = backslash & (~backslash + 1);
+        if (escaped & bit) {
+            continue;
+        }
+        if (bit == std::uint64_t(1) << 63) {
+            state.escaped = 1;
+        } else {
+            escaped |= bit << 1;
+        }
+    }
+    const auto quote = masks.quote & ~escaped;
+    // the bits from an opening quote up to (not including) its closing quote
+    const auto in_string = prefix_xor(quote) ^ state.in_string;
+    state.in_string = std::uint64_t(0) - (in_string >> 63);
+    const auto open = masks.open & ~in_string;
+    const auto close = masks.close & ~in_string;
+    return {open | close | (masks.separator & ~in_string) | quote, open, close};
+}
+
+// copies the last partial block into a buffer padded with spaces.
+inline const char* pad_block(const char* p, std::size_t size, char (&buffer)[64]) noexcept {
+    std::memset(buffer, ' ', sizeof(buffer));
+    std::memcpy(buffer, p, size);
+    return buffer;
+}
+
+// the loops are repeated for each instruction set so that the classification is inlined.
+inline void build_index_scalar(std::string_view text, index_word* words) noexcept {
+    index_state state;
+    const auto blocks = text.size() / 64;
+    for (std::size_t i = 0; i < blocks; ++i) {
+        words[i] = make_index_word(classify_scalar(text.data() + i * 64), state);
+    }
+    if (text.size() % 64) {
+        char buffer[64];
+        auto block = pad_block(text.data() + blocks * 64, text.size() % 64, buffer);
+        words[blocks] = make_index_word(classify_scalar(block), state);
+    }
+}
+
+#if JSON_ACCESS_HELPER_HAS_SSE2_
+inline void build_index_sse2(std::string_view text, index_word* words) noexcept {
+    index_state state;
+    const auto blocks = text.size() / 64;
+    for (std::size_t i = 0; i < blocks; ++i) {
+        words[i] = make_index_word(classify_sse2(text.data() + i * 64), state);
+    }
+    if (text.size() % 64) {
+        char buffer[64];
+        auto block = pad_block(text.data() + blocks * 64, text.size() % 64, buffer);
+        words[blocks] = make_index_word(classify_sse2(block), state);
+    }
+}
+#endif
+
+#if JSON_ACCESS_HELPER_HAS_AVX2_
+__attribute__((target("avx2")))
+inline void build_index_avx2(std::string_view text, index_word* words) noexcept {
+    index_state state;
+    const auto blocks = text.size() / 64;
+    for (std::size_t i = 0; i < blocks; ++i) {
+        words[i] = make_index_word(classify_avx2(text.data() + i * 64), state);
+    }
+    if (text.size() % 64) {
+        char buffer[64];
+        auto block = pad_block(text.data() + blocks * 64, text.size() % 64, buffer);
+        words[blocks] = make_index_word(classify_avx2(block), state);
+    }
+}
+#endif
+
+JSON_ACCESS_HELPER_ALWAYS_INLINE_ inline unsigned popcount(std::uint64_t x) noexcept {
+#if defined(__GNUC__)
+    return static_cast<unsigned>(__builtin_popcountll(x));
+#else
+    unsigned n = 0;
+    for (; x != 0; x &= x - 1) {
+        ++n;
+    }
+    return n;
+#endif
+}
+
+JSON_ACCESS_HELPER_ALWAYS_INLINE_ inline unsigned count_trailing_zeros(std::uint64_t x) noexcept {
+#if defined(__GNUC__)
+    return static_cast<unsigned>(__builtin_ctzll(x));
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, x);
+    return static_cast<unsigned>(index);
+#else
+    unsigned n = 0;
+    for (; !(x & 1); x >>= 1) {
+        ++n;
+    }
+    return n;
+#endif
+}
+
+// returns the position of the bracket which closes the array or object beginning at pos.
+// The result is not less than the number of words * 64 if it is not closed.
+JSON_ACCESS_HELPER_ALWAYS_INLINE_
+inline std::size_t find_close(const index_word* words, std::size_t size, std::size_t pos) noexcept {
+    std::size_t depth = 1;
+    // the shift is split so that the bits after pos are selected even if pos % 64 is 63
+    auto mask = ~std::uint64_t(0) << (pos % 64) << 1;
+    for (auto word = pos / 64; word < size; ++word, mask = ~std::uint64_t(0)) {
+        auto open = words[word].open & mask;
+        auto close = words[word].close & mask;
+        // the brackets are visited one by one only in the block where the depth can be zero
+        if (popcount(close) < depth) {
+            depth = depth + popcount(open) - popcount(close);
+            continue;
+        }
+        for (; close != 0; close &= close - 1) {
+            const auto below = (close & (~close + 1)) - 1;
+            depth += popcount(open & below);
+            open &= ~below;
+            if (--depth == 0) {
+                return word * 64 + count_trailing_zeros(close);
+            }
+        }
+        depth += popcount(open);
+    }
+    return size * 64;
+}
+
+#if JSON_ACCESS_HELPER_HAS_AVX2_
+// every CPU with AVX2 has POPCNT.
+__attribute__((target("popcnt")))
+inline std::size_t find_close_popcnt(const index_word* words, std::size_t size, std::size_t pos) noexcept {
+    return find_close(words, size, pos);
+}
+#endif
+
+}  // namespace detail
+
+// Instruction sets that can build structural_index.
+enum class simd_level {
+    scalar,
+    sse2,
+    avx2,
+};
+
+// Returns the best instruction set supported by the running CPU.
+inline simd_level supported_simd_level() noexcept {
+#if JSON_ACCESS_HELPER_HAS_AVX2_
+    static const auto level = __builtin_cpu_supports("avx2") ? simd_level::avx2 : simd_level::sse2;
+    return level;
+#elif JSON_ACCESS_HELPER_HAS_SSE2_
+    return simd_level::sse2;
+#else
+    return simd_level::scalar;
+#endif
+}
+
+// Index of the structural characters of JSON text.
+//
+// The index has bitmaps of the text, which mark the unescaped quotes and { } [ ] : , outside
+// strings. The lookup functions taking the index jump between these characters, and skip
+// arrays and objects by counting the brackets of 64 bytes at a time, so the skipped strings
+// and values are not scanned byte by byte.
+// The text must outlive the index.
+class structural_index {
+public:
+    explicit structural_index(std::string_view text, simd_level level = supported_simd_level())
+        : text_(text), words_((text.size() + 63) / 64), level_(level) {
+        switch (level) {
+#if JSON_ACCESS_HELPER_HAS_AVX2_
+        case simd_level::avx2:
+            detail::build_index_avx2(text_, words_.data());
+            break;
+#endif
+#if JSON_ACCESS_HELPER_HAS_SSE2_
+        case simd_level::sse2:
+            detail::build_index_sse2(text_, words_.data());
+            break;
+#endif
+        default:
+            detail::build_index_scalar(text_, words_.data());
+            break;
+        }
+    }
+
+    std::string_view text() const noexcept {
+        return text_;
+    }
+
+    // Returns the position of the first structural character at or after pos, or the size
+    // of the text if there is none.
+    std::size_t next(std::size_t pos) const noexcept {
+        auto word = pos / 64;
+        if (word >= words_.size()) {
+            return text_.size();
+        }
+        auto bits = words_[word].structural & (~std::uint64_t(0) << (pos % 64));
+        while (bits == 0) {
+            if (++word == words_.size()) {
+                return text_.size();
+            }
+            bits = words_[word].structural;
+        }
+        return word * 64 + detail::count_trailing_zeros(bits);
+    }
+
+    // Returns the position of the bracket which closes the array or object beginning at pos,
+    // or the size of the text if it is not closed.
+    std::size_t close(std::size_t pos) const noexcept {
+        std::size_t last;
+#if JSON_ACCESS_HELPER_HAS_AVX2_
+        if (level_ == simd_level::avx2) {
+            last = detail::find_close_popcnt(words_.data(), words_.size(), pos);
+        } else
+#endif
+        {
+            last = detail::find_close(words_.data(), words_.size(), pos);
+        }
+        return last < text_.size() ? last : text_.size();
+    }
+
+private:
+    std::string_view text_;
+    std::vector<detail::index_word> words_;
+    simd_level level_;
+};
+
+namespace detail {
+
+inline std::size_t skip_whitespace(std::string_view text, std::size_t pos) noexcept {
+    return static_cast<std::size_t>(skip_whitespace(text.data() + pos, text.data() + text.size()) - text.data());
+}
+
+// skips the value which begins at pos by following the structural characters, and returns
+// the position after it. The skipped text is not validated.
+inline std::size_t skip_value(const structural_index& index, std::size_t pos, boost::json::error_code& ec) noexcept {
+    const auto text = index.text();
+    if (pos == text.size()) {
+        ec = boost::json::error::incomplete;
+        return pos;
+    }
+    if (text[pos] == '"') {
+        auto last = index.next(pos + 1);
+        if (last == text.size()) {
+            ec = boost::json::error::incomplete;
+            return last;
+        }
+        return last + 1;
+    }
+    if (text[pos] != '{' && text[pos] != '[') {
+        auto last = index.next(pos);
+        while (last != pos && (text[last - 1] == ' ' || text[last - 1] == '\t'
+                               || text[last - 1] == '\n' || text[last - 1] == '\r')) {
+            --last;
+        }
+        return last;
+    }
+    auto last = index.close(pos);
+    if (last == text.size()) {
+        ec = boost::json::error::incomplete;
+        return last;
+    }
+    return last + 1;
+}
+
+// finds the text of the value referred to by the tokens with the structural index.
+inline std::string_view find_text(const structural_index& index, const token* first, const token* last,
+                                  boost::json::error_code& ec) {
+    const auto text = index.text();
+    const auto end = text.size();
+    auto p = skip_whitespace(text, 0);
+    for (auto it = first; it != last; ++it) {
+        if (p == end) {
+            ec = boost::json::error::incomplete;
+            return {};
+        }
+        if (text[p] == '{') {
+            p = index.next(p + 1);
+            if (p != end && text[p] == '}') {
+                ec = boost::json::error::not_found;
+                return {};
+            }
+            while (true) {
+                if (p == end || text[p] != '"') {
+                    ec = p == end ? boost::json::error::incomplete : boost::json::error::syntax;
+                    return {};
+                }
+                auto key_last = index.next(p + 1);
+                if (key_last == end) {
+                    ec = boost::json::error::incomplete;
+                    return {};
+                }
+                bool matched = key_text_equals(text.substr(p, key_last - p + 1), it->key, ec);
+                if (ec) {
+                    return {};
+                }
+                p = index.next(key_last + 1);
+                if (p == end || text[p] != ':') {
+                    ec = p == end ? boost::json::error::incomplete : boost::json::error::syntax;
+                    return {};
+                }
+                p = skip_whitespace(text, p + 1);
+                if (matched) {
+                    break;
+                }
+                p = skip_value(index, p, ec);
+                if (ec) {
+                    return {};
+                }
+                p = index.next(p);
+                if (p != end && text[p] == ',') {
+                    p = index.next(p + 1);
+                    continue;
+                }
+                ec = p == end ? boost::json::error::incomplete
+                   : text[p] == '}' ? boost::json::error::not_found
+                   : boost::json::error::syntax;
+                return {};
+            }
+        } else if (text[p] == '[') {
+            if (it->kind != token_kind::index) {
+                ec = it->kind == token_kind::past_the_end
+                    ? boost::json::error::past_the_end
+                    : boost::json::error::token_not_number;
+                return {};
+            }
+            p = skip_whitespace(text, p + 1);
+            if (p != end && text[p] == ']') {
+                ec = boost::json::error::not_found;
+                return {};
+            }
+            for (std::size_t i = 0; i < it->index; ++i) {
+                p = skip_value(index, p, ec);
+                if (ec) {
+                    return {};
+                }
+                p = index.next(p);
+                if (p == end || text[p] != ',') {
+                    ec = p == end ? boost::json::error::incomplete
+                       : text[p] == ']' ? boost::json::error::not_found
+                       : boost::json::error::syntax;
+                    return {};
+                }
+                p = skip_whitespace(text, p + 1);
+            }
+        } else {
+            ec = boost::json::error::value_is_scalar;
+            return {};
+        }
+    }
+    auto value_end = skip_value(index, p, ec);
+    if (ec) {
+        return {};
+    }
+    return text.substr(p, value_end - p);
+}
+
+// returns true if the text is a number in the JSON grammar, and sets integral to true if
+// it has neither a fraction nor an exponent.
+inline bool scan_number(std::string_view text, bool& integral) noexcept {
+    auto is_digit = [&](std::size_t i) { return i < text.size() && text[i] >= '0' && text[i] <= '9'; };
+    std::size_t i = 0;
+    if (i < text.size() && text[i] == '-') {
+        ++i;
+    }
+    if (!is_digit(i)) {
+        return false;
+    }
+    if (text[i++] != '0') {
+        while (is_digit(i)) {
+            ++i;
+        }
+    }
+    integral = true;
+    if (i < text.size() && text[i] == '.') {
+        integral = false;
+        if (!is_digit(++i)) {
+            return false;
+        }
+        while (is_digit(i)) {
+            ++i;
+        }
+    }
+    if (i < text.size() && (text[i] == 'e' || text[i] == 'E')) {
+        integral = false;
+        if (++i < text.size() && (text[i] == '+' || text[i] == '-')) {
+            ++i;
+        }
+        if (!is_digit(i)) {
+            return false;
+        }
+        while (is_digit(i)) {
+            ++i;
+        }
+    }
+    return i == text.size();
+}
+
+// decodes the text of a number directly into the arithmetic type T, so that an integral
+// type never goes through floating point.
+// Returns false if the text needs the general conversion: it is not a number, it is out of
+// the range of T, or it has a fraction or an exponent for an integral type.
+template <class T>
+bool decode_number(std::string_view text, T& out) noexcept {
+    bool integral = false;
+    if (!scan_number(text, integral)) {
+        return false;
+    }
+    if constexpr (std::is_integral_v<T>) {
+        if (!integral) {
+            return false;
+        }
+    }
+    if constexpr (std::is_integral_v<T> || has_floating_charconv) {
+        const auto last = text.data() + text.size();
+        auto [ptr, ec] = std::from_chars(text.data(), last, out);
+        return ec == std::errc() && ptr == last;
+    } else {
+        // converted by Boost.JSON
+        return false;
+    }
+}
+
+// Source is std::string_view or structural_index.
+// Numbers are decoded from the text according to the type of the tag, and the other values
+// are parsed and converted by value_to. A std::string_view value refers to the text, so it is
+// an error (not_exact) if the string has escapes.
+template <class Tag, class Source>
+boost::json::result<typename Tag::value_type> try_read_text(const Source& source) {
+    const auto& tokens = pointer_traits<Tag>::tokens;
+    boost::json::error_code ec;
+    auto value_text = find_text(source, tokens.data(), tokens.data() + tokens.size(), ec);
+    if (ec) {
+        return ec;
+    }
+    using value_type = typename Tag::value_type;
+    if constexpr (std::is_arithmetic_v<value_type> && !std::is_same_v<value_type, bool>) {
+        value_type number;
+        if (decode_number(value_text, number)) {
+            return number;
+        }
+    }
+    unsigned char buffer[1024];
+    boost::json::monotonic_resource resource(buffer, sizeof(buffer));
+    // a result which would refer to the value is converted from the default resource
+    boost::json::storage_ptr sp;
+    if constexpr (owns_storage_v<value_type> || std::is_same_v<value_type, std::string_view>) {
+        sp = boost::json::storage_ptr(&resource);
+    }
+    auto jv = boost::json::parse(value_text, ec, std::move(sp));
+    if (ec) {
+        return ec;
+    }
+    if constexpr (std::is_same_v<value_type, std::string_view>) {
+        // refers to the text of the string, which is the parsed string unless it has escapes
+        if (auto str = jv.if_string()) {
+            auto raw = value_text.substr(1, value_text.size() - 2);
+            if (str->size() != raw.size()) {
+                return boost::json::error::not_exact;
+            }
+            return raw;
+        }
+    }
+    return boost::json::try_value_to<value_type>(jv);
+}
+
+}  // namespace detail
+
+// Reads the value of the tag from JSON text without parsing the whole text.
+//
+// The values before the tag's value are skipped by matching brackets and quotes, and only
+// the text of the tag's value is parsed. The skipped text is not validated.
+// Throws exception if any error occurs.
+template <class Tag, class = std::enable_if_t<is_accessor_tag_v<Tag>>>
+typename Tag::value_type read(std::string_view text, const Tag&) {
+    return detail::try_read_text<Tag>(text).value();
+}
+
+template <class Tag, class = std::enable_if_t<is_accessor_tag_v<Tag>>>
+typename Tag::value_type read(const char* text, const Tag& tag) {
+    return read(std::string_view(text), tag);
+}
+
+// Tries to read the value of the tag from JSON text without parsing the whole text.
+template <class Tag, class = std::enable_if_t<is_accessor_tag_v<Tag>>>
+boost::json::result<typename Tag::value_type> try_read(std::string_view text, const Tag&) {
+    return detail::try_read_text<Tag>(text);
+}
+
+template <class Tag, class = std::enable_if_t<is_accessor_tag_v<Tag>>>
+boost::json::result<typename Tag::value_type> try_read(const char* text, const Tag& tag) {
+    return try_read(std::string_view(text), tag);
+}
+
+// Reads the value of the tag from JSON text with its structural index.
+//
+// Building the index costs one pass over the text, and each lookup jumps between the
+// structural characters. This is faster than the functions taking the text when several
+// values are read from a large text.
+// Throws exception if any error occurs.
+template <class Tag, class = std::enable_if_t<is_accessor_tag_v<Tag>>>
+typename Tag::value_type read(const structural_index& index, const Tag&) {
+    return detail::try_read_text<Tag>(index).value();
+}
+
+// Tries to read the value of the tag from JSON text with its structural index.
+template <class Tag, class = std::enable_if_t<is_accessor_tag_v<Tag>>>
+boost::json::result<typename Tag::value_type> try_read(const structural_index& index, const Tag&) {
+    return detail::try_read_text<Tag>(index);
+}
+
+}  // namespace json_access_helper
+
+#endif  // JSON_ACCESS_HELPER_TEXT_HPP_
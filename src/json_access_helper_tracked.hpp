@@ -0,0 +1,459 @@
+#ifndef JSON_ACCESS_HELPER_TRACKED_HPP_
+#define JSON_ACCESS_HELPER_TRACKED_HPP_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <boost/json.hpp>
+
+#include "json_access_helper.hpp"
+
+namespace json_access_helper {
+
+namespace detail {
+
+struct text_node;
+struct tracked_access;
+
+struct text_member {
+    std::string key;     // the key of an object member
+    std::string prefix;  // the serialized key and ':' of an object member
+    std::unique_ptr<text_node> node;
+};
+
+// Cached text of a subtree.
+//
+// A node which is not expanded has the serialized text of its subtree. An expanded node has
+// a node for each member or element instead, and its text is made of theirs. A dirty node
+// is serialized again, or synchronized with its value if it is expanded.
+// The text is in the buffer of the node, or is a part of the buffer of an expanded ancestor,
+// which keeps its buffer for the members.
+struct text_node {
+    std::string_view text;
+    std::string buffer;
+    std::vector<text_member> members;
+    bool expanded = false;
+    bool dirty = true;
+};
+
+inline void set_text(text_node& node, std::string text) {
+    node.buffer = std::move(text);
+    node.text = node.buffer;
+}
+
+inline void clear_text(text_node& node) {
+    node.text = {};
+    node.buffer = std::string();
+}
+
+inline std::unique_ptr<text_node> make_text_node(std::string_view text) {
+    auto node = std::make_unique<text_node>();
+    node->text = text;
+    node->dirty = text.empty();
+    return node;
+}
+
+inline std::string key_prefix(boost::json::string_view key) {
+    auto prefix = boost::json::serialize(key);
+    prefix += ':';
+    return prefix;
+}
+
+// returns the end of the value which starts at pos in serialized text: the position after a
+// string or container, or of the ',' or closing bracket after a literal.
+inline std::size_t skip_value(std::string_view text, std::size_t pos) noexcept {
+    std::size_t depth = 0;
+    bool in_string = false;
+    for (; pos < text.size(); ++pos) {
+        const char c = text[pos];
+        if (in_string) {
+            if (c == '\\') {
+                ++pos;
+            } else if (c == '"') {
+                in_string = false;
+                if (depth == 0) {
+                    return pos + 1;
+                }
+            }
+        } else if (c == '"') {
+            in_string = true;
+        } else if (c == '{' || c == '[') {
+            ++depth;
+        } else if (c == '}' || c == ']') {
+            if (depth == 0) {
+                return pos;
+            }
+            if (--depth == 0) {
+                return pos + 1;
+            }
+        } else if (c == ',' && depth == 0) {
+            return pos;
+        }
+    }
+    return pos;
+}
+
+// splits the text of a container into the parts for each member: the key and ':' of an
+// object member, and the value. Stops at the first part which is not well formed.
+inline void split_text(std::string_view text, std::vector<std::pair<std::string_view, std::string_view>>& parts) {
+    parts.clear();
+    const bool is_object = !text.empty() && text.front() == '{';
+    const char close = is_object ? '}' : ']';
+    std::size_t pos = 1;
+    while (pos < text.size() && text[pos] != close) {
+        std::string_view prefix;
+        if (is_object) {
+            const auto colon = skip_value(text, pos);
+            if (colon >= text.size() || text[colon] != ':') {
+                return;
+            }
+            prefix = text.substr(pos, colon + 1 - pos);
+            pos = colon + 1;
+        }
+        const auto end = skip_value(text, pos);
+        if (end >= text.size() || end == pos || (text[end] != ',' && text[end] != close)) {
+            return;
+        }
+        parts.emplace_back(prefix, text.substr(pos, end - pos));
+        pos = text[end] == ',' ? end + 1 : end;
+    }
+}
+
+// true if prefix is the serialized key and ':'.
+inline bool is_key_prefix(std::string_view prefix, boost::json::string_view key) {
+    if (prefix.size() == key.size() + 3 && prefix.compare(1, key.size(), key.data(), key.size()) == 0) {
+        return true;
+    }
+    return prefix == key_prefix(key);
+}
+
+// splits the text of a node into the nodes of the members of its container.
+// Returns false if the value is not a container.
+//
+// The members refer to the parts of the node's text, which is scanned once for them without
+// serializing anything again. The text may be older than the value if the value has been
+// changed before it is marked, in which case the members whose part is not at their position
+// (those added since) are dirty, and the changed member is marked by the caller.
+inline bool expand(text_node& node, const boost::json::value& jv) {
+    const auto obj = jv.if_object();
+    const auto arr = jv.if_array();
+    if (!obj && !arr) {
+        return false;
+    }
+    std::vector<std::pair<std::string_view, std::string_view>> parts;
+    if (!node.text.empty() && node.text.front() == (obj ? '{' : '[')) {
+        split_text(node.text, parts);
+    }
+    node.members.clear();
+    if (obj) {
+        node.members.reserve(obj->size());
+        std::size_t i = 0;
+        for (const auto& member : *obj) {
+            if (i < parts.size() && is_key_prefix(parts[i].first, member.key())) {
+                node.members.push_back(text_member{std::string(member.key()), std::string(parts[i].first),
+                                                   make_text_node(parts[i].second)});
+            } else {
+                node.members.push_back(text_member{std::string(member.key()), key_prefix(member.key()),
+                                                   std::make_unique<text_node>()});
+            }
+            ++i;
+        }
+    } else {
+        node.members.reserve(arr->size());
+        for (std::size_t i = 0; i < arr->size(); ++i) {
+            node.members.push_back(text_member{{}, {}, make_text_node(i < parts.size() ? parts[i].second : std::string_view())});
+        }
+    }
+    // the buffer is kept for the members
+    node.text = {};
+    node.expanded = true;
+    return true;
+}
+
+inline void collapse(text_node& node) {
+    node.members = std::vector<text_member>();
+    clear_text(node);
+    node.expanded = false;
+    node.dirty = true;
+}
+
+// matches the members of an expanded node with the members of its value, which may have
+// been added by emplace. Members not in the node are added as dirty nodes.
+inline void synchronize(text_node& node, const boost::json::value& jv) {
+    if (auto obj = jv.if_object()) {
+        std::vector<text_member> members;
+        members.reserve(obj->size());
+        std::unordered_map<std::string_view, std::size_t> positions;
+        std::size_t i = 0;
+        for (const auto& member : *obj) {
+            const std::string_view key(member.key().data(), member.key().size());
+            text_member* old = nullptr;
+            if (i < node.members.size() && node.members[i].key == key) {
+                old = &node.members[i];
+            } else {
+                if (positions.empty()) {
+                    for (std::size_t j = 0; j < node.members.size(); ++j) {
+                        positions.emplace(node.members[j].key, j);
+                    }
+                }
+                auto it = positions.find(key);
+                old = it != positions.end() ? &node.members[it->second] : nullptr;
+            }
+            if (old && old->node) {
+                members.push_back(std::move(*old));
+            } else {
+                members.push_back(text_member{std::string(key), key_prefix(member.key()),
+                                              std::make_unique<text_node>()});
+            }
+            ++i;
+        }
+        node.members = std::move(members);
+    } else if (auto arr = jv.if_array()) {
+        // accessors replace or append elements, so the elements keep their positions
+        const auto size = arr->size();
+        node.members.resize(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            if (!node.members[i].node) {
+                node.members[i].node = std::make_unique<text_node>();
+            }
+        }
+    } else {
+        collapse(node);
+    }
+}
+
+inline std::size_t container_size(const boost::json::value& jv) noexcept {
+    if (auto obj = jv.if_object()) {
+        return obj->size();
+    }
+    if (auto arr = jv.if_array()) {
+        return arr->size();
+    }
+    return 0;
+}
+
+inline void collect_segments(text_node& node, const boost::json::value& jv,
+                             std::vector<std::string_view>& segments) {
+    // a container whose size differs has been changed without being marked
+    if (node.expanded && (node.dirty || node.members.size() != container_size(jv))) {
+        synchronize(node, jv);
+    }
+    node.dirty = false;
+    if (!node.expanded) {
+        if (node.text.empty()) {
+            set_text(node, boost::json::serialize(jv));
+        }
+        segments.push_back(node.text);
+        return;
+    }
+    if (auto obj = jv.if_object()) {
+        segments.push_back("{");
+        std::size_t i = 0;
+        for (const auto& member : *obj) {
+            if (i != 0) {
+                segments.push_back(",");
+            }
+            segments.push_back(node.members[i].prefix);
+            collect_segments(*node.members[i].node, member.value(), segments);
+            ++i;
+        }
+        segments.push_back("}");
+    } else {
+        const auto& arr = jv.get_array();
+        segments.push_back("[");
+        for (std::size_t i = 0; i < arr.size(); ++i) {
+            if (i != 0) {
+                segments.push_back(",");
+            }
+            collect_segments(*node.members[i].node, arr[i], segments);
+        }
+        segments.push_back("]");
+    }
+}
+
+}  // namespace detail
+
+// Document which serializes only the subtrees changed since the last serialization.
+//
+// The text of each subtree is cached. The writes through the functions below mark the
+// subtrees on the pointers as dirty, and the containers on the pointers are split into the
+// texts of their members. Serialization regenerates the dirty subtrees only and splices the
+// cached text of the others, so its cost is close to the size of the change and the number of
+// members of the containers on the changed pointers.
+// The first change under a container scans its cached text once to split it, which costs
+// about a copy of the text but serializes nothing. The split text is kept for its members.
+// A value changed through a pointer returned by reference() after the next serialization must
+// be marked by mark_dirty() again. Other changes must be made through modify().
+class tracked_document {
+public:
+    explicit tracked_document(boost::json::value jv = {})
+        : jv_(std::move(jv)), root_(std::make_unique<detail::text_node>()) {}
+
+    tracked_document(tracked_document&&) noexcept = default;
+    tracked_document& operator=(tracked_document&&) noexcept = default;
+
+    const boost::json::value& value() const noexcept {
+        return jv_;
+    }
+
+    // Returns the document to be modified directly. The whole document is serialized again.
+    boost::json::value& modify() noexcept {
+        detail::collapse(*root_);
+        return jv_;
+    }
+
+    // Marks the value of the tag as changed through a pointer.
+    template <class Tag, class = std::enable_if_t<is_accessor_tag_v<Tag>>>
+    void mark_dirty(const Tag&) {
+        const auto& tokens = pointer_traits<Tag>::tokens;
+        mark(tokens.data(), tokens.data() + tokens.size());
+    }
+
+    // Returns the text of the document as segments referring to the cached texts, e.g. for
+    // writev. They are valid until the document is changed or serialized again.
+    const std::vector<std::string_view>& serialize_segments() {
+        segments_.clear();
+        detail::collect_segments(*root_, jv_, segments_);
+        return segments_;
+    }
+
+    // Serializes the document into out.
+    void serialize(std::string& out) {
+        const auto& segments = serialize_segments();
+        std::size_t size = 0;
+        for (auto segment : segments) {
+            size += segment.size();
+        }
+        out.clear();
+        out.reserve(size);
+        for (auto segment : segments) {
+            out.append(segment.data(), segment.size());
+        }
+    }
+
+    std::string serialize() {
+        std::string out;
+        serialize(out);
+        return out;
+    }
+
+    // Marks the nodes on the pointer as dirty, expanding them so that only the subtree at
+    // the end of the pointer is serialized again.
+    void mark(const token* first, const token* last) {
+        detail::text_node* node = root_.get();
+        const boost::json::value* jv = &jv_;
+        for (auto it = first; it != last; ++it) {
+            node->dirty = true;
+            if (!node->expanded && !detail::expand(*node, *jv)) {
+                detail::clear_text(*node);
+                return;
+            }
+            std::size_t i = 0;
+            if (auto obj = jv->if_object()) {
+                auto member = detail::find_member(*obj, *it);
+                if (member == obj->end()) {
+                    return;
+                }
+                i = static_cast<std::size_t>(member - obj->begin());
+                jv = &member->value();
+                // a member added after the node was expanded is added by synchronize()
+                if (i >= node->members.size() || node->members[i].key != it->key) {
+                    return;
+                }
+            } else if (auto arr = jv->if_array()) {
+                // "-" refers to the last element, which an empty array does not have
+                if (it->kind == token_kind::key || (it->kind == token_kind::past_the_end && arr->empty())) {
+                    return;
+                }
+                i = it->kind == token_kind::index ? it->index : arr->size() - 1;
+                if (i >= arr->size() || i >= node->members.size() || !node->members[i].node) {
+                    return;
+                }
+                jv = &(*arr)[i];
+            } else {
+                return;
+            }
+            node = node->members[i].node.get();
+        }
+        detail::collapse(*node);
+    }
+
+private:
+    boost::json::value jv_;
+    std::unique_ptr<detail::text_node> root_;
+    std::vector<std::string_view> segments_;
+
+    friend struct detail::tracked_access;
+};
+
+namespace detail {
+
+// gives the functions below the document without marking it.
+struct tracked_access {
+    static boost::json::value& value(tracked_document& doc) noexcept {
+        return doc.jv_;
+    }
+};
+
+// calls f on the value of the document and marks the tag dirty even if f throws, since an
+// existing value on the pointer may have been partly written.
+// If the tag cannot be marked either, the whole document is serialized again.
+template <class Tag, class F>
+decltype(auto) tracked_change(tracked_document& doc, const Tag& tag, F f) {
+    try {
+        return f(tracked_access::value(doc));
+    } catch (...) {
+        try {
+            doc.mark_dirty(tag);
+        } catch (...) {
+            doc.modify();
+        }
+        throw;
+    }
+}
+
+}  // namespace detail
+
+// Writes the value of the tag, reusing the storage of the existing value, and marks it dirty.
+// Returns false if the value does not exist.
+template <class Tag, class = std::enable_if_t<is_accessor_tag_v<Tag>>>
+bool write(tracked_document& doc, const Tag& tag, const typename Tag::value_type& value) {
+    const bool written = detail::tracked_change(doc, tag, [&](boost::json::value& jv) {
+        return write(jv, tag, value);
+    });
+    if (written) {
+        doc.mark_dirty(tag);
+    }
+    return written;
+}
+
+// Writes the value of the tag, creating the missing objects and arrays, and marks it dirty.
+template <class Tag, class = std::enable_if_t<is_accessor_tag_v<Tag>>>
+boost::json::value& emplace(tracked_document& doc, const Tag& tag, const typename Tag::value_type& value) {
+    auto& ref = detail::tracked_change(doc, tag, [&](boost::json::value& jv) -> boost::json::value& {
+        return emplace(jv, tag, value);
+    });
+    doc.mark_dirty(tag);
+    return ref;
+}
+
+// Returns the value of the tag to be modified, or nullptr if it does not exist. The value is
+// marked dirty.
+template <class Tag, class = std::enable_if_t<is_accessor_tag_v<Tag>>>
+boost::json::value* reference(tracked_document& doc, const Tag& tag) {
+    auto ref = reference(detail::tracked_access::value(doc), tag);
+    if (ref) {
+        doc.mark_dirty(tag);
+    }
+    return ref;
+}
+
+}  // namespace json_access_helper
+
+#endif  // JSON_ACCESS_HELPER_TRACKED_HPP_
@@ -0,0 +1,329 @@
+#ifndef JSON_ACCESS_HELPER_WILDCARD_HPP_
+#define JSON_ACCESS_HELPER_WILDCARD_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <mutex>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <boost/json.hpp>
+
+#include "json_access_helper.hpp"
+#include "json_access_helper_pool.hpp"
+
+namespace json_access_helper {
+
+// Base class of the tags defined by DEFINE_JSON_WILDCARD_ACCESSOR.
+struct wildcard_tag {};
+
+// Execution policy of the parallel read of a wildcard accessor.
+//
+// threads: the maximum number of chunks, which are collected by the threads of the shared
+//          pool. 0 means the size of the pool, std::thread::hardware_concurrency().
+// grain:   the minimum number of elements of the first wildcard per chunk.
+struct parallel_policy {
+    unsigned threads = 0;
+    std::size_t grain = 4096;
+};
+
+inline constexpr parallel_policy parallel = {};
+
+namespace detail {
+
+// "*" is a wildcard in the pointer of a wildcard accessor.
+constexpr bool is_wildcard(const token& t) {
+    return t.kind == token_kind::key && t.key == "*";
+}
+
+template <class Tag>
+struct wildcard_traits {
+    static constexpr const auto& tokens = pointer_traits<Tag>::tokens;
+
+    static constexpr std::size_t count = [] {
+        std::size_t n = 0;
+        for (const auto& t : pointer_traits<Tag>::tokens) {
+            n += is_wildcard(t) ? 1 : 0;
+        }
+        return n;
+    }();
+
+    // token position of the first wildcard
+    static constexpr std::size_t first = [] {
+        std::size_t i = 0;
+        while (i < pointer_traits<Tag>::size && !is_wildcard(pointer_traits<Tag>::tokens[i])) {
+            ++i;
+        }
+        return i;
+    }();
+
+    static_assert(count != 0, "the pointer of a wildcard accessor must have \"*\"");
+};
+
+inline const token* find_wildcard(const token* first, const token* last) noexcept {
+    return std::find_if(first, last, [](const token& t) { return is_wildcard(t); });
+}
+
+// Returns the number of the elements or members of the container.
+inline std::size_t fan_out_size(const boost::json::value& jv) noexcept {
+    if (auto arr = jv.if_array()) {
+        return arr->size();
+    }
+    if (auto obj = jv.if_object()) {
+        return obj->size();
+    }
+    return 0;
+}
+
+// Returns the i-th element or member value of the container.
+inline const boost::json::value& fan_out_at(const boost::json::value& jv, std::size_t i) noexcept {
+    if (auto arr = jv.if_array()) {
+        return (*arr)[i];
+    }
+    return jv.get_object().begin()[i].value();
+}
+
+// Appends the values at [first, last) from jv, expanding each wildcard to all elements of an
+// array or all member values of an object, in order.
+template <class T>
+bool collect(const boost::json::value& jv, const token* first, const token* last, std::vector<T>& out,
+             boost::json::error_code& ec) {
+    auto star = find_wildcard(first, last);
+    auto p = find(jv, first, star, ec);
+    if (!p) {
+        return false;
+    }
+    if (star == last) {
+        auto r = boost::json::try_value_to<T>(*p);
+        if (!r) {
+            ec = r.error();
+            return false;
+        }
+        out.push_back(std::move(*r));
+        return true;
+    }
+    if (!p->is_array() && !p->is_object()) {
+        ec = boost::json::error::value_is_scalar;
+        return false;
+    }
+    const auto n = fan_out_size(*p);
+    for (std::size_t i = 0; i < n; ++i) {
+        if (!collect(fan_out_at(*p, i), star + 1, last, out, ec)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Collects the values below the elements [begin, end) of the container at the first wildcard.
+template <class Tag>
+bool collect_range(const boost::json::value& container, std::size_t begin, std::size_t end,
+                   std::vector<typename Tag::value_type>& out, boost::json::error_code& ec) {
+    const auto& tokens = wildcard_traits<Tag>::tokens;
+    const auto first = tokens.data() + wildcard_traits<Tag>::first + 1;
+    const auto last = tokens.data() + tokens.size();
+    for (std::size_t i = begin; i < end; ++i) {
+        if (!collect(fan_out_at(container, i), first, last, out, ec)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Returns the container at the first wildcard, or nullptr.
+template <class Tag>
+const boost::json::value* find_fan_out(const boost::json::value& jv, boost::json::error_code& ec) noexcept {
+    const auto& tokens = wildcard_traits<Tag>::tokens;
+    auto p = find(jv, tokens.data(), tokens.data() + wildcard_traits<Tag>::first, ec);
+    if (p && !p->is_array() && !p->is_object()) {
+        ec = boost::json::error::value_is_scalar;
+        return nullptr;
+    }
+    return p;
+}
+
+template <class Tag>
+bool read_wildcard(const boost::json::value& jv, std::vector<typename Tag::value_type>& out,
+                   boost::json::error_code& ec) {
+    out.clear();
+    auto container = find_fan_out<Tag>(jv, ec);
+    if (!container) {
+        return false;
+    }
+    // exact if the pointer has only one wildcard
+    const auto n = fan_out_size(*container);
+    out.reserve(n);
+    return collect_range<Tag>(*container, 0, n, out, ec);
+}
+
+// Splits the elements of the first wildcard into chunks, which are collected by the shared
+// pool. The calling thread is one of its workers.
+// If another thread is using the pool, the elements are collected on the calling thread.
+// If the pointer has only one wildcard, each thread writes its chunk of the result directly.
+// Otherwise, each thread collects its chunk into its own vector, and they are concatenated.
+template <class Tag>
+bool read_wildcard(const parallel_policy& policy, const boost::json::value& jv,
+                   std::vector<typename Tag::value_type>& out, boost::json::error_code& ec) {
+    using value_type = typename Tag::value_type;
+    // std::vector<bool> cannot be written from several threads
+    constexpr bool direct = wildcard_traits<Tag>::count == 1 && std::is_default_constructible_v<value_type>
+        && !std::is_same_v<value_type, bool>;
+
+    out.clear();
+    auto container = find_fan_out<Tag>(jv, ec);
+    if (!container) {
+        return false;
+    }
+    const auto n = fan_out_size(*container);
+    const std::size_t threads = policy.threads != 0 ? policy.threads : shared_pool().size();
+    const auto chunks = std::min(threads, n / std::max<std::size_t>(policy.grain, 1));
+    std::unique_lock<std::mutex> lock(shared_pool_mutex(), std::defer_lock);
+    if (chunks <= 1 || shared_pool().size() == 1 || !lock.try_lock()) {
+        out.reserve(n);
+        return collect_range<Tag>(*container, 0, n, out, ec);
+    }
+
+    if constexpr (direct) {
+        out.resize(n);
+    }
+    std::vector<std::vector<value_type>> parts(direct ? 0 : chunks);
+    std::vector<boost::json::error_code> errors(chunks);
+    std::vector<std::exception_ptr> exceptions(chunks);
+    auto collect_chunk = [&](std::size_t c) {
+        const auto begin = n * c / chunks;
+        const auto end = n * (c + 1) / chunks;
+        if constexpr (direct) {
+            const auto& tokens = wildcard_traits<Tag>::tokens;
+            const auto first = tokens.data() + wildcard_traits<Tag>::first + 1;
+            const auto last = tokens.data() + tokens.size();
+            for (auto i = begin; i < end; ++i) {
+                auto p = find(fan_out_at(*container, i), first, last, errors[c]);
+                if (!p) {
+                    return;
+                }
+                auto r = boost::json::try_value_to<value_type>(*p);
+                if (!r) {
+                    errors[c] = r.error();
+                    return;
+                }
+                out[i] = std::move(*r);
+            }
+        } else {
+            parts[c].reserve(end - begin);
+            collect_range<Tag>(*container, begin, end, parts[c], errors[c]);
+        }
+    };
+    // the exception of the first chunk in order is rethrown by the calling thread
+    auto job = [&](unsigned, std::size_t c) noexcept {
+        try {
+            collect_chunk(c);
+        } catch (...) {
+            exceptions[c] = std::current_exception();
+        }
+    };
+    shared_pool().run(chunks, job);
+    lock.unlock();
+    for (auto& exception : exceptions) {
+        if (exception) {
+            out.clear();
+            std::rethrow_exception(exception);
+        }
+    }
+
+    // the error of the first element in order
+    for (const auto& error : errors) {
+        if (error) {
+            ec = error;
+            out.clear();
+            return false;
+        }
+    }
+    if constexpr (!direct) {
+        std::size_t total = 0;
+        for (const auto& part : parts) {
+            total += part.size();
+        }
+        out.reserve(total);
+        for (auto& part : parts) {
+            std::move(part.begin(), part.end(), std::back_inserter(out));
+        }
+    }
+    return true;
+}
+
+}  // namespace detail
+
+// Reads the values of the wildcard accessor in one traversal.
+// Throws exception if any of them does not exist or cannot be converted.
+template <class Tag, class = std::enable_if_t<std::is_base_of_v<wildcard_tag, Tag>>>
+std::vector<typename Tag::value_type> read(const boost::json::value& jv, const Tag&) {
+    std::vector<typename Tag::value_type> out;
+    boost::json::error_code ec;
+    if (!detail::read_wildcard<Tag>(jv, out, ec)) {
+        throw boost::system::system_error(ec);
+    }
+    return out;
+}
+
+// Reads the values of the wildcard accessor with several threads.
+template <class Tag, class = std::enable_if_t<std::is_base_of_v<wildcard_tag, Tag>>>
+std::vector<typename Tag::value_type> read(const parallel_policy& policy, const boost::json::value& jv,
+                                           const Tag&) {
+    std::vector<typename Tag::value_type> out;
+    boost::json::error_code ec;
+    if (!detail::read_wildcard<Tag>(policy, jv, out, ec)) {
+        throw boost::system::system_error(ec);
+    }
+    return out;
+}
+
+// Tries to read the values of the wildcard accessor.
+template <class Tag, class = std::enable_if_t<std::is_base_of_v<wildcard_tag, Tag>>>
+boost::json::result<std::vector<typename Tag::value_type>> try_read(const boost::json::value& jv, const Tag&) {
+    std::vector<typename Tag::value_type> out;
+    boost::json::error_code ec;
+    if (!detail::read_wildcard<Tag>(jv, out, ec)) {
+        return ec;
+    }
+    return out;
+}
+
+template <class Tag, class = std::enable_if_t<std::is_base_of_v<wildcard_tag, Tag>>>
+boost::json::result<std::vector<typename Tag::value_type>> try_read(const parallel_policy& policy,
+                                                                    const boost::json::value& jv, const Tag&) {
+    std::vector<typename Tag::value_type> out;
+    boost::json::error_code ec;
+    if (!detail::read_wildcard<Tag>(policy, jv, out, ec)) {
+        return ec;
+    }
+    return out;
+}
+
+// Reads the values of the wildcard accessor into out, reusing its capacity.
+// Throws exception if any error occurs. out is empty then.
+template <class Tag, class = std::enable_if_t<std::is_base_of_v<wildcard_tag, Tag>>>
+void read_into(const boost::json::value& jv, const Tag&, std::vector<typename Tag::value_type>& out) {
+    boost::json::error_code ec;
+    if (!detail::read_wildcard<Tag>(jv, out, ec)) {
+        out.clear();
+        throw boost::system::system_error(ec);
+    }
+}
+
+}  // namespace json_access_helper
+
+// Defines a wildcard accessor whose pointer has "*", e.g. "/users/*/age". Each "*" is
+// expanded to all elements of an array or all member values of an object, and read
+// returns std::vector<Type>.
+#define DEFINE_JSON_WILDCARD_ACCESSOR(Tag, Type, Key)                                       \
+    struct Tag##T : ::json_access_helper::wildcard_tag {                                    \
+        using value_type = Type;                                                            \
+        static constexpr std::string_view json_pointer = Key;                               \
+    };                                                                                      \
+    inline constexpr Tag##T Tag = {};
+
+#endif  // JSON_ACCESS_HELPER_WILDCARD_HPP_
@@ -0,0 +1,421 @@
+#include "json_access_helper.hpp"
+#include "json_access_helper_batch.hpp"
+#include "json_access_helper_bind.hpp"
+#include "json_access_helper_param.hpp"
+#include "json_access_helper_wildcard.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <boost/json.hpp>
+
+using std::string;
+using std::vector;
+
+#define MAKE_JSON_ACCESSOR DECLARE_AND_DEFINE_JSON_ACCESSOR
+
+namespace json_accessor_bench_impl {
+
+MAKE_JSON_ACCESSOR(Depth1, int,         "/k0")
+MAKE_JSON_ACCESSOR(Depth2, int,         "/k0/k1")
+MAKE_JSON_ACCESSOR(Depth4, int,         "/k0/k1/k2/k3")
+MAKE_JSON_ACCESSOR(Depth8, int,         "/k0/k1/k2/k3/k4/k5/k6/k7")
+MAKE_JSON_ACCESSOR(Values, vector<int>, "/values")
+
+// a config update of 20 values
+MAKE_JSON_ACCESSOR(Config00, int, "/config/s0/k0")
+MAKE_JSON_ACCESSOR(Config01, int, "/config/s0/k1")
+MAKE_JSON_ACCESSOR(Config02, int, "/config/s0/k2")
+MAKE_JSON_ACCESSOR(Config03, int, "/config/s0/k3")
+MAKE_JSON_ACCESSOR(Config04, int, "/config/s0/k4")
+MAKE_JSON_ACCESSOR(Config10, int, "/config/s1/k0")
+MAKE_JSON_ACCESSOR(Config11, int, "/config/s1/k1")
+MAKE_JSON_ACCESSOR(Config12, int, "/config/s1/k2")
+MAKE_JSON_ACCESSOR(Config13, int, "/config/s1/k3")
+MAKE_JSON_ACCESSOR(Config14, int, "/config/s1/k4")
+MAKE_JSON_ACCESSOR(Config20, int, "/config/s2/k0")
+MAKE_JSON_ACCESSOR(Config21, int, "/config/s2/k1")
+MAKE_JSON_ACCESSOR(Config22, int, "/config/s2/k2")
+MAKE_JSON_ACCESSOR(Config23, int, "/config/s2/k3")
+MAKE_JSON_ACCESSOR(Config24, int, "/config/s2/k4")
+MAKE_JSON_ACCESSOR(Config30, int, "/config/s3/k0")
+MAKE_JSON_ACCESSOR(Config31, int, "/config/s3/k1")
+MAKE_JSON_ACCESSOR(Config32, int, "/config/s3/k2")
+MAKE_JSON_ACCESSOR(Config33, int, "/config/s3/k3")
+MAKE_JSON_ACCESSOR(Config34, int, "/config/s3/k4")
+
+DEFINE_JSON_PARAM_ACCESSOR(ItemValue, int, "/items/{}/value")
+DEFINE_JSON_WILDCARD_ACCESSOR(ItemValues, int, "/items/*/value")
+
+}  // namespace json_accessor_bench_impl
+
+// Each generated accessor function is measured against the hand-written code with
+// at_pointer / find_pointer / set_at_pointer doing the same thing.
+//
+// arg width: the number of members of each object on the pointer. The member of the
+//            pointer is the last one.
+// arg hit:   the percentage of the documents which have the value of the tag.
+// arg size:  the number of array elements.
+namespace {
+
+namespace json = boost::json;
+namespace tag = json_accessor_bench_impl;
+
+template <class Tag>
+constexpr json::string_view pointer_of() {
+    constexpr auto ptr = json_access_helper::pointer_traits<Tag>::string;
+    return json::string_view(ptr.data(), ptr.size());
+}
+
+// nests objects along "/k0/k1/...", each of which has width members.
+// The last key is renamed if hit is false.
+json::value make_document(std::size_t depth, std::size_t width, bool hit) {
+    json::value jv = 42;
+    for (std::size_t d = depth; d-- > 0;) {
+        json::object obj;
+        for (std::size_t i = 0; i + 1 < width; ++i) {
+            obj["f" + std::to_string(i)] = static_cast<std::int64_t>(i);
+        }
+        obj[!hit && d + 1 == depth ? "miss" : "k" + std::to_string(d)] = std::move(jv);
+        jv = std::move(obj);
+    }
+    return jv;
+}
+
+// documents which have the tag at the ratio of the hit percentage
+class document_set {
+public:
+    document_set(std::size_t depth, std::size_t width, std::size_t hit_percent)
+        : hit_(make_document(depth, width, true)), miss_(make_document(depth, width, false)) {
+        // 37 is coprime with 100, so the hits are spread over the sequence
+        for (std::size_t i = 0; i < docs_.size(); ++i) {
+            docs_[i] = (i * 37) % 100 < hit_percent ? &hit_ : &miss_;
+        }
+    }
+
+    const json::value& operator[](std::size_t i) const noexcept {
+        return *docs_[i % docs_.size()];
+    }
+
+private:
+    json::value hit_;
+    json::value miss_;
+    std::array<const json::value*, 100> docs_;
+};
+
+template <class Tag>
+constexpr std::size_t depth_of() {
+    return json_access_helper::pointer_traits<Tag>::size;
+}
+
+void width_args(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"width"})->RangeMultiplier(8)->Range(1, 512);
+}
+
+void width_hit_args(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"width", "hit"})->ArgsProduct({{1, 8, 64, 512}, {100, 50, 0}});
+}
+
+void size_args(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"size"})->RangeMultiplier(16)->Range(1, 65536);
+}
+
+template <class Tag>
+void BM_Read(benchmark::State& state) {
+    const auto jv = make_document(depth_of<Tag>(), state.range(0), true);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(read(jv, Tag{}));
+    }
+}
+
+template <class Tag>
+void BM_ReadAtPointer(benchmark::State& state) {
+    const auto jv = make_document(depth_of<Tag>(), state.range(0), true);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(static_cast<int>(jv.at_pointer(pointer_of<Tag>()).as_int64()));
+    }
+}
+
+// resolved once by bind
+template <class Tag>
+void BM_ReadBound(benchmark::State& state) {
+    auto jv = make_document(depth_of<Tag>(), state.range(0), true);
+    const auto view = json_access_helper::bind(jv, Tag{});
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(read(view, Tag{}));
+    }
+}
+
+template <class Tag>
+void BM_TryRead(benchmark::State& state) {
+    const document_set docs(depth_of<Tag>(), state.range(0), state.range(1));
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(try_read(docs[i++], Tag{}));
+    }
+}
+
+template <class Tag>
+void BM_TryReadFindPointer(benchmark::State& state) {
+    const document_set docs(depth_of<Tag>(), state.range(0), state.range(1));
+    std::size_t i = 0;
+    for (auto _ : state) {
+        json::error_code ec;
+        int value = 0;
+        if (auto p = docs[i++].find_pointer(pointer_of<Tag>(), ec)) {
+            if (auto n = p->if_int64()) {
+                value = static_cast<int>(*n);
+            }
+        }
+        benchmark::DoNotOptimize(value);
+        benchmark::DoNotOptimize(ec);
+    }
+}
+
+template <class Tag>
+void BM_Write(benchmark::State& state) {
+    auto jv = make_document(depth_of<Tag>(), state.range(0), true);
+    int value = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(write(jv, Tag{}, ++value));
+    }
+}
+
+template <class Tag>
+void BM_WriteAtPointer(benchmark::State& state) {
+    auto jv = make_document(depth_of<Tag>(), state.range(0), true);
+    int value = 0;
+    for (auto _ : state) {
+        json::error_code ec;
+        if (auto p = jv.find_pointer(pointer_of<Tag>(), ec)) {
+            *p = ++value;
+        }
+        benchmark::DoNotOptimize(jv);
+    }
+}
+
+template <class Tag>
+void BM_Emplace(benchmark::State& state) {
+    auto jv = make_document(depth_of<Tag>(), state.range(0), true);
+    int value = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(&emplace(jv, Tag{}, ++value));
+    }
+}
+
+template <class Tag>
+void BM_SetAtPointer(benchmark::State& state) {
+    auto jv = make_document(depth_of<Tag>(), state.range(0), true);
+    int value = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(&jv.set_at_pointer(pointer_of<Tag>(), ++value));
+    }
+}
+
+template <class Tag>
+void BM_Reference(benchmark::State& state) {
+    const document_set docs(depth_of<Tag>(), state.range(0), state.range(1));
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(reference(docs[i++], Tag{}));
+    }
+}
+
+template <class Tag>
+void BM_ReferenceFindPointer(benchmark::State& state) {
+    const document_set docs(depth_of<Tag>(), state.range(0), state.range(1));
+    std::size_t i = 0;
+    for (auto _ : state) {
+        json::error_code ec;
+        benchmark::DoNotOptimize(docs[i++].find_pointer(pointer_of<Tag>(), ec));
+    }
+}
+
+// registers the benchmark for each pointer depth
+#define JSON_BENCH_DEPTHS_(bm, args)                                  \
+    BENCHMARK_TEMPLATE(bm, tag::Depth1T)->Apply(args);                \
+    BENCHMARK_TEMPLATE(bm, tag::Depth2T)->Apply(args);                \
+    BENCHMARK_TEMPLATE(bm, tag::Depth4T)->Apply(args);                \
+    BENCHMARK_TEMPLATE(bm, tag::Depth8T)->Apply(args)
+
+JSON_BENCH_DEPTHS_(BM_Read,                 width_args);
+JSON_BENCH_DEPTHS_(BM_ReadAtPointer,        width_args);
+JSON_BENCH_DEPTHS_(BM_ReadBound,            width_args);
+JSON_BENCH_DEPTHS_(BM_TryRead,              width_hit_args);
+JSON_BENCH_DEPTHS_(BM_TryReadFindPointer,   width_hit_args);
+JSON_BENCH_DEPTHS_(BM_Write,                width_args);
+JSON_BENCH_DEPTHS_(BM_WriteAtPointer,       width_args);
+JSON_BENCH_DEPTHS_(BM_Emplace,              width_args);
+JSON_BENCH_DEPTHS_(BM_SetAtPointer,         width_args);
+JSON_BENCH_DEPTHS_(BM_Reference,            width_hit_args);
+JSON_BENCH_DEPTHS_(BM_ReferenceFindPointer, width_hit_args);
+
+json::value make_array_document(std::size_t size) {
+    json::array values;
+    values.reserve(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        values.emplace_back(static_cast<std::int64_t>(i));
+    }
+    json::object obj;
+    obj["values"] = std::move(values);
+    return obj;
+}
+
+void BM_ReadArray(benchmark::State& state) {
+    const auto jv = make_array_document(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(read(jv, tag::Values));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ReadArray)->Apply(size_args);
+
+// reuses the capacity of the vector
+void BM_ReadIntoArray(benchmark::State& state) {
+    const auto jv = make_array_document(state.range(0));
+    vector<int> out;
+    for (auto _ : state) {
+        read_into(jv, tag::Values, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ReadIntoArray)->Apply(size_args);
+
+void BM_ReadArrayHandWritten(benchmark::State& state) {
+    const auto jv = make_array_document(state.range(0));
+    for (auto _ : state) {
+        const auto& arr = jv.at_pointer("/values").as_array();
+        vector<int> out;
+        out.reserve(arr.size());
+        for (const auto& element : arr) {
+            out.push_back(static_cast<int>(element.as_int64()));
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ReadArrayHandWritten)->Apply(size_args);
+
+// arg existing: 1 if the values exist before the update, 0 if the document is empty
+template <class... Tags>
+void BM_EmplaceEach(benchmark::State& state) {
+    const auto base = state.range(0) ? json::value(json::object()) : json::value();
+    json::value existing = base;
+    (emplace(existing, Tags{}, 0), ...);
+    for (auto _ : state) {
+        auto jv = state.range(0) ? existing : base;
+        int value = 0;
+        (emplace(jv, Tags{}, ++value), ...);
+        benchmark::DoNotOptimize(jv);
+    }
+}
+
+template <class... Tags>
+void BM_SetAtPointerEach(benchmark::State& state) {
+    const auto base = state.range(0) ? json::value(json::object()) : json::value();
+    json::value existing = base;
+    (emplace(existing, Tags{}, 0), ...);
+    for (auto _ : state) {
+        auto jv = state.range(0) ? existing : base;
+        int value = 0;
+        (jv.set_at_pointer(pointer_of<Tags>(), ++value), ...);
+        benchmark::DoNotOptimize(jv);
+    }
+}
+
+template <class... Tags>
+void BM_WriteBatch(benchmark::State& state) {
+    const auto base = state.range(0) ? json::value(json::object()) : json::value();
+    json::value existing = base;
+    (emplace(existing, Tags{}, 0), ...);
+    json_access_helper::write_batch<Tags...> batch;
+    for (auto _ : state) {
+        auto jv = state.range(0) ? existing : base;
+        int value = 0;
+        (batch.emplace(Tags{}, ++value), ...);
+        benchmark::DoNotOptimize(batch.apply(jv));
+        benchmark::DoNotOptimize(jv);
+    }
+}
+
+#define JSON_BENCH_CONFIG_TAGS_ tag::Config00T, tag::Config01T, tag::Config02T, tag::Config03T, tag::Config04T, tag::Config10T, tag::Config11T, tag::Config12T, tag::Config13T, tag::Config14T, tag::Config20T, tag::Config21T, tag::Config22T, tag::Config23T, tag::Config24T, tag::Config30T, tag::Config31T, tag::Config32T, tag::Config33T, tag::Config34T
+
+BENCHMARK_TEMPLATE(BM_EmplaceEach, JSON_BENCH_CONFIG_TAGS_)->Name("BM_EmplaceEach<Config>")->ArgNames({"existing"})->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_SetAtPointerEach, JSON_BENCH_CONFIG_TAGS_)->Name("BM_SetAtPointerEach<Config>")->ArgNames({"existing"})->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_WriteBatch, JSON_BENCH_CONFIG_TAGS_)->Name("BM_WriteBatch<Config>")->ArgNames({"existing"})->Arg(0)->Arg(1);
+
+json::value make_item_document(std::size_t size) {
+    json::array items;
+    items.reserve(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        json::object item;
+        item["value"] = static_cast<std::int64_t>(i);
+        items.emplace_back(std::move(item));
+    }
+    json::object obj;
+    obj["items"] = std::move(items);
+    return obj;
+}
+
+void BM_ReadParam(benchmark::State& state) {
+    const auto size = static_cast<std::size_t>(state.range(0));
+    const auto jv = make_item_document(size);
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(read(jv, tag::ItemValue(i++ % size)));
+    }
+}
+BENCHMARK(BM_ReadParam)->Apply(size_args);
+
+// formats the pointer of each element
+void BM_ReadParamAtPointer(benchmark::State& state) {
+    const auto size = static_cast<std::size_t>(state.range(0));
+    const auto jv = make_item_document(size);
+    std::size_t i = 0;
+    for (auto _ : state) {
+        const auto ptr = "/items/" + std::to_string(i++ % size) + "/value";
+        benchmark::DoNotOptimize(static_cast<int>(jv.at_pointer(ptr).as_int64()));
+    }
+}
+BENCHMARK(BM_ReadParamAtPointer)->Apply(size_args);
+
+void BM_ReadWildcard(benchmark::State& state) {
+    const auto jv = make_item_document(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(read(jv, tag::ItemValues));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ReadWildcard)->Apply(size_args);
+
+void BM_ReadWildcardParallel(benchmark::State& state) {
+    const auto jv = make_item_document(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(read(json_access_helper::parallel, jv, tag::ItemValues));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ReadWildcardParallel)->Apply(size_args)->UseRealTime();
+
+// builds and parses the pointer of each element
+void BM_ReadWildcardAtPointer(benchmark::State& state) {
+    const auto size = static_cast<std::size_t>(state.range(0));
+    const auto jv = make_item_document(size);
+    for (auto _ : state) {
+        vector<int> out;
+        for (std::size_t i = 0; i < size; ++i) {
+            const auto ptr = "/items/" + std::to_string(i) + "/value";
+            out.push_back(static_cast<int>(jv.at_pointer(ptr).as_int64()));
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ReadWildcardAtPointer)->Apply(size_args);
+
+}  // namespace
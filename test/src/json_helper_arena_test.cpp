@@ -0,0 +1,109 @@
+#include "json_access_helper_arena.hpp"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/json.hpp>
+#include <gtest/gtest.h>
+
+namespace json = boost::json;
+using std::string;
+using std::vector;
+
+#define MAKE_JSON_ACCESSOR DECLARE_AND_DEFINE_JSON_ACCESSOR
+
+namespace json_arena_test_impl {
+
+MAKE_JSON_ACCESSOR(UserName,  string,         "/user/name")
+MAKE_JSON_ACCESSOR(UserAge,   int,            "/user/age")
+MAKE_JSON_ACCESSOR(UserLangs, vector<string>, "/user/languages")
+
+}  // namespace json_arena_test_impl
+
+namespace {
+
+namespace tag = json_arena_test_impl;
+
+TEST(JsonArena, Document) {
+    json_access_helper::document_pool pool;
+
+    auto document = pool.acquire();
+    auto& jv = document.value();
+    EXPECT_TRUE(jv.is_null());
+
+    emplace(jv, tag::UserName,  string("Alice"));
+    emplace(jv, tag::UserAge,   23);
+    emplace(jv, tag::UserLangs, vector<string>{"C++", "Python"});
+    EXPECT_EQ(jv, (json::value{{"user", {{"name", "Alice"}, {"age", 23}, {"languages", {"C++", "Python"}}}}}));
+    EXPECT_EQ(jv.at("user").at("languages").storage(), jv.storage());
+    EXPECT_GT(document.used(), 0u);
+
+    // the moved document is returned to the pool once
+    auto moved = std::move(document);
+    EXPECT_EQ(read(moved.value(), tag::UserAge), 23);
+    moved.reset();
+    moved.reset();
+}
+
+TEST(JsonArena, Recycle) {
+    json_access_helper::document_pool pool(1024);
+
+    const json::value* previous = nullptr;
+    for (int i = 0; i < 3; ++i) {
+        auto document = pool.acquire();
+        emplace(document.value(), tag::UserName, string(100, 'x'));
+        // the buffer and the resource of the previous document are reused
+        if (previous) {
+            EXPECT_EQ(&document.value(), previous);
+        }
+        previous = &document.value();
+    }
+}
+
+TEST(JsonArena, BlockSize) {
+    json_access_helper::document_pool pool(1024);
+    EXPECT_EQ(pool.block_size(), 1024u);
+
+    // grows to the size of a large document
+    std::size_t used = 0;
+    {
+        auto document = pool.acquire();
+        emplace(document.value(), tag::UserLangs, vector<string>(100, string(100, 'x')));
+        used = document.used();
+    }
+    EXPECT_GE(pool.block_size(), used);
+
+    // shrinks gradually to the size of small documents
+    for (int i = 0; i < 200; ++i) {
+        auto document = pool.acquire();
+        emplace(document.value(), tag::UserAge, i);
+    }
+    EXPECT_LT(pool.block_size(), used);
+    EXPECT_GE(pool.block_size(), 1024u);
+
+    // the buffers of the large documents are not kept
+    auto document = pool.acquire();
+    EXPECT_GE(document.capacity(), pool.block_size());
+    EXPECT_LE(document.capacity(), pool.block_size() * 2);
+}
+
+TEST(JsonArena, Threads) {
+    json_access_helper::document_pool pool;
+
+    vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&pool, t] {
+            for (int i = 0; i < 100; ++i) {
+                auto document = pool.acquire();
+                emplace(document.value(), tag::UserAge, t * 100 + i);
+                EXPECT_EQ(read(document.value(), tag::UserAge), t * 100 + i);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+}  // namespace
@@ -0,0 +1,133 @@
+#include "json_access_helper_batch.hpp"
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include <boost/json.hpp>
+#include <gtest/gtest.h>
+
+namespace json = boost::json;
+using std::string;
+using std::vector;
+
+#define MAKE_JSON_ACCESSOR DECLARE_AND_DEFINE_JSON_ACCESSOR
+
+namespace json_batch_test_impl {
+
+MAKE_JSON_ACCESSOR(UserName,  string,         "/user/name")
+MAKE_JSON_ACCESSOR(UserAge,   int,            "/user/age")
+MAKE_JSON_ACCESSOR(UserLangs, vector<string>, "/user/languages")
+MAKE_JSON_ACCESSOR(FirstLang, string,         "/user/languages/0")
+MAKE_JSON_ACCESSOR(Theme,     string,         "/settings/ui/theme")
+MAKE_JSON_ACCESSOR(FontSize,  int,            "/settings/ui/font/size")
+MAKE_JSON_ACCESSOR(Nickname,  string,         "/user/nickname")
+MAKE_JSON_ACCESSOR(NameChar,  string,         "/user/name/0")
+MAKE_JSON_ACCESSOR(AX,        int,            "/a/x")
+MAKE_JSON_ACCESSOR(BY,        int,            "/b/y")
+MAKE_JSON_ACCESSOR(BZ,        int,            "/b/z")
+MAKE_JSON_ACCESSOR(ExtraGap,  int,            "/user/extra/list/3")
+MAKE_JSON_ACCESSOR(ExtraName, string,         "/user/extra/name")
+MAKE_JSON_ACCESSOR(LangKey,   string,         "/user/languages/x/y")
+
+}  // namespace json_batch_test_impl
+
+namespace {
+
+const auto template_json = json::parse(R"({
+    "id": 1,
+    "user": {
+        "name": "Alice",
+        "age": 23,
+        "languages": ["C++", "Python"]
+    }
+})");
+
+namespace tag = json_batch_test_impl;
+
+TEST(JsonBatch, Write) {
+    auto jv = template_json;
+    auto batch = json_access_helper::make_write_batch(tag::UserName, tag::UserAge, tag::FirstLang, tag::Nickname,
+                                                      tag::Theme);
+    EXPECT_TRUE(batch.empty());
+    batch.write(tag::UserName, "Bob").write(tag::UserAge, 30).write(tag::FirstLang, "Rust").write(tag::Nickname, "B");
+
+    // the same as write for each tag. Theme is not set
+    EXPECT_EQ(batch.apply(jv), (std::array<bool, 5>{true, true, true, false, false}));
+    EXPECT_EQ(read(jv, tag::UserName),  "Bob");
+    EXPECT_EQ(read(jv, tag::UserAge),   30);
+    EXPECT_EQ(read(jv, tag::UserLangs), (vector<string>{"Rust", "Python"}));
+    EXPECT_FALSE(reference(jv, tag::Nickname));
+    EXPECT_FALSE(reference(jv, tag::Theme));
+
+    batch.clear();
+    EXPECT_TRUE(batch.empty());
+    EXPECT_EQ(batch.apply(jv), (std::array<bool, 5>{}));
+}
+
+TEST(JsonBatch, Emplace) {
+    json::value jv;
+    auto batch = json_access_helper::make_write_batch(tag::Theme, tag::FontSize, tag::UserName, tag::UserLangs,
+                                                      tag::NameChar);
+    batch.emplace(tag::Theme, "dark")
+        .emplace(tag::FontSize, 12)
+        .emplace(tag::UserName, "Alice")
+        .emplace(tag::UserLangs, {"C++"})
+        .emplace(tag::NameChar, "A");
+
+    // "/user/name/0" fails on the string written before it
+    EXPECT_EQ(batch.apply(jv), (std::array<bool, 5>{true, true, true, true, false}));
+    EXPECT_EQ(jv, json::parse(R"({
+        "settings": {"ui": {"theme": "dark", "font": {"size": 12}}},
+        "user": {"name": "Alice", "languages": ["C++"]}
+    })"));
+
+    // a created object has capacity for the children in the batch
+    EXPECT_GE(jv.at("settings").at("ui").as_object().capacity(), 2u);
+    EXPECT_GE(jv.at("user").as_object().capacity(), 2u);
+
+    // emplace and write are mixed in the order of the pointers
+    auto mixed = json_access_helper::make_write_batch(tag::UserAge, tag::Nickname, tag::UserName);
+    mixed.write(tag::Nickname, "A").emplace(tag::UserAge, 23).write(tag::UserName, "Carol");
+    EXPECT_EQ(mixed.apply(jv), (std::array<bool, 3>{true, false, true}));
+    EXPECT_EQ(read(jv, tag::UserAge),  23);
+    EXPECT_EQ(read(jv, tag::UserName), "Carol");
+}
+
+TEST(JsonBatch, EmplaceFailsPartWay) {
+    // "/user/extra/list/3" creates "extra" and "list" before the index gap
+    auto jv = template_json;
+    auto batch = json_access_helper::make_write_batch(tag::ExtraGap, tag::LangKey);
+    batch.emplace(tag::ExtraGap, 1).emplace(tag::LangKey, "x");
+    EXPECT_EQ(batch.apply(jv), (std::array<bool, 2>{false, false}));
+    EXPECT_EQ(jv, template_json);
+
+    // the next tag creates the removed values again
+    auto shared = json_access_helper::make_write_batch(tag::ExtraGap, tag::ExtraName);
+    shared.emplace(tag::ExtraGap, 1).emplace(tag::ExtraName, "e");
+    EXPECT_EQ(shared.apply(jv), (std::array<bool, 2>{false, true}));
+    EXPECT_EQ(jv.at("user").at("extra"), json::parse(R"({"name": "e"})"));
+
+    // a null value made an object or array is null again
+    json::value null_jv;
+    auto gap = json_access_helper::make_write_batch(tag::ExtraGap);
+    gap.emplace(tag::ExtraGap, 1);
+    EXPECT_EQ(gap.apply(null_jv), (std::array<bool, 1>{false}));
+    EXPECT_TRUE(null_jv.is_null());
+}
+
+TEST(JsonBatch, UnsetTag) {
+    // "/b/y" is not set and is visited between the others
+    auto jv = json::parse(R"({"a": {"x": 0}, "b": {"y": 0, "z": 0}})");
+    auto batch = json_access_helper::make_write_batch(tag::AX, tag::BY, tag::BZ);
+    batch.write(tag::AX, 1).write(tag::BZ, 3);
+    EXPECT_EQ(batch.apply(jv), (std::array<bool, 3>{true, false, true}));
+    EXPECT_EQ(jv, json::parse(R"({"a": {"x": 1}, "b": {"y": 0, "z": 3}})"));
+
+    batch.clear();
+    batch.emplace(tag::AX, 2).emplace(tag::BZ, 4);
+    EXPECT_EQ(batch.apply(jv), (std::array<bool, 3>{true, false, true}));
+    EXPECT_EQ(jv, json::parse(R"({"a": {"x": 2}, "b": {"y": 0, "z": 4}})"));
+}
+
+}  // namespace
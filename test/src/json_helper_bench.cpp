@@ -0,0 +1,477 @@
+#include "json_access_helper_columnar.hpp"
+#include "json_access_helper_mmap.hpp"
+#include "json_access_helper_ndjson.hpp"
+#include "json_access_helper_serialize.hpp"
+#include "json_access_helper_text.hpp"
+#include "json_access_helper_tracked.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <boost/json.hpp>
+
+using std::string;
+using std::vector;
+
+#define MAKE_JSON_ACCESSOR DECLARE_AND_DEFINE_JSON_ACCESSOR
+
+namespace json_bench_impl {
+
+MAKE_JSON_ACCESSOR(UserName,  string,         "/user/name")
+MAKE_JSON_ACCESSOR(UserAge,   int,            "/user/age")
+MAKE_JSON_ACCESSOR(UserLangs, vector<string>, "/user/languages")
+MAKE_JSON_ACCESSOR(UserCity,  string,         "/user/address/city")
+MAKE_JSON_ACCESSOR(Sample,    int,            "/samples/900/count")
+MAKE_JSON_ACCESSOR(Latency,   double,         "/samples/900/latency")
+MAKE_JSON_ACCESSOR(Revision,  int,            "/state/revision")
+MAKE_JSON_ACCESSOR(Status,    string,         "/state/status")
+MAKE_JSON_ACCESSOR(ItemId,    int,            "/items/9000/id")
+
+}  // namespace json_bench_impl
+
+// counts the allocations on the heap
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+// operator delete replaced below is paired with operator new replaced below
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+namespace {
+
+std::atomic<std::size_t> heap_allocations{0};
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+    heap_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (auto p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+namespace json = boost::json;
+namespace tag = json_bench_impl;
+
+using json_access_helper::simd_level;
+using json_access_helper::structural_index;
+
+// a large document whose tags are at its end
+const string& corpus() {
+    static const auto text = [] {
+        string text = "{\"items\": [";
+        for (int i = 0; i < 20000; ++i) {
+            text += i == 0 ? "" : ", ";
+            text += "{\"id\": " + std::to_string(i)
+                  + ", \"text\": \"line \\\"" + std::to_string(i) + "\\\" {not: [structural]}\""
+                  + ", \"values\": [1.5, true, null, \"x\"]}";
+        }
+        text += "], \"user\": {\"name\": \"Alice\", \"age\": 23}}";
+        return text;
+    }();
+    return text;
+}
+
+void BM_Parse(benchmark::State& state) {
+    const auto& text = corpus();
+    for (auto _ : state) {
+        auto jv = json::parse(text);
+        benchmark::DoNotOptimize(read(jv, tag::UserName));
+        benchmark::DoNotOptimize(read(jv, tag::UserAge));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+BENCHMARK(BM_Parse);
+
+void BM_ReadText(benchmark::State& state) {
+    const auto text = std::string_view(corpus());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(read(text, tag::UserName));
+        benchmark::DoNotOptimize(read(text, tag::UserAge));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+BENCHMARK(BM_ReadText);
+
+// arg: simd_level
+void BM_BuildStructuralIndex(benchmark::State& state) {
+    const auto level = static_cast<simd_level>(state.range(0));
+    if (level > json_access_helper::supported_simd_level()) {
+        state.SkipWithError("not supported");
+        return;
+    }
+    const auto& text = corpus();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(structural_index(text, level));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+BENCHMARK(BM_BuildStructuralIndex)->DenseRange(0, 2);
+
+// builds the index and reads the tags with it
+void BM_ReadStructuralIndex(benchmark::State& state) {
+    const auto& text = corpus();
+    for (auto _ : state) {
+        const auto index = structural_index(text);
+        benchmark::DoNotOptimize(read(index, tag::UserName));
+        benchmark::DoNotOptimize(read(index, tag::UserAge));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+BENCHMARK(BM_ReadStructuralIndex);
+
+// a document of numbers, a few of which are read
+const string& telemetry() {
+    static const auto text = [] {
+        string text = "{\"samples\": [";
+        for (int i = 0; i < 1000; ++i) {
+            text += i == 0 ? "" : ", ";
+            text += "{\"count\": " + std::to_string(i * 7919)
+                  + ", \"latency\": " + std::to_string(i * 0.731)
+                  + ", \"values\": [" + std::to_string(i * 1.25) + ", " + std::to_string(i * 3.5e-3)
+                  + ", " + std::to_string(-i * 2.75e2) + "]}";
+        }
+        text += "]}";
+        return text;
+    }();
+    return text;
+}
+
+// every number is converted by the parser
+void BM_ParseTelemetry(benchmark::State& state) {
+    const auto& text = telemetry();
+    for (auto _ : state) {
+        auto jv = json::parse(text);
+        benchmark::DoNotOptimize(read(jv, tag::Sample));
+        benchmark::DoNotOptimize(read(jv, tag::Latency));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+BENCHMARK(BM_ParseTelemetry);
+
+// only the numbers of the tags are decoded
+void BM_ReadTelemetryIndex(benchmark::State& state) {
+    const auto& text = telemetry();
+    for (auto _ : state) {
+        const auto index = structural_index(text);
+        benchmark::DoNotOptimize(read(index, tag::Sample));
+        benchmark::DoNotOptimize(read(index, tag::Latency));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+BENCHMARK(BM_ReadTelemetryIndex);
+
+// counts the allocations of the upstream resource
+class counting_resource : public json::memory_resource {
+public:
+    std::size_t allocations = 0;
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t align) override {
+        ++allocations;
+        return ::operator new(bytes, std::align_val_t(align));
+    }
+
+    void do_deallocate(void* p, std::size_t, std::size_t align) override {
+        ::operator delete(p, std::align_val_t(align));
+    }
+
+    bool do_is_equal(const json::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+// builds a document with the accessors
+void emplace_document(json::value& jv, const string& name, const vector<string>& langs) {
+    emplace(jv, tag::UserName,  name);
+    emplace(jv, tag::UserAge,   23);
+    emplace(jv, tag::UserLangs, langs);
+    emplace(jv, tag::UserCity,  name);
+}
+
+const string name = "a name longer than the small buffer";
+const vector<string> langs(16, "a language longer than the small buffer");
+
+void BM_EmplaceHeap(benchmark::State& state) {
+    const auto before = heap_allocations.load();
+    for (auto _ : state) {
+        json::value jv;
+        emplace_document(jv, name, langs);
+        benchmark::DoNotOptimize(jv);
+    }
+    state.counters["heap_allocations"] = benchmark::Counter(
+        static_cast<double>(heap_allocations.load() - before), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_EmplaceHeap);
+
+// the document is built on a request-scoped arena
+void BM_EmplaceArena(benchmark::State& state) {
+    unsigned char buffer[8192];
+    counting_resource upstream;
+    const auto before = heap_allocations.load();
+    for (auto _ : state) {
+        json::monotonic_resource resource(buffer, sizeof(buffer), json::storage_ptr(&upstream));
+        auto jv = json::value(json::storage_ptr(&resource));
+        emplace_document(jv, name, langs);
+        benchmark::DoNotOptimize(jv);
+    }
+    state.counters["heap_allocations"] = benchmark::Counter(
+        static_cast<double>(heap_allocations.load() - before), benchmark::Counter::kAvgIterations);
+    state.counters["upstream_allocations"] = benchmark::Counter(
+        static_cast<double>(upstream.allocations), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_EmplaceArena);
+
+// the response text is built through a document
+void BM_SerializeDocument(benchmark::State& state) {
+    const auto before = heap_allocations.load();
+    for (auto _ : state) {
+        json::value jv;
+        emplace_document(jv, name, langs);
+        benchmark::DoNotOptimize(json::serialize(jv));
+    }
+    state.counters["heap_allocations"] = benchmark::Counter(
+        static_cast<double>(heap_allocations.load() - before), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_SerializeDocument);
+
+// the response text is written directly into a buffer
+void BM_Serializer(benchmark::State& state) {
+    json_access_helper::serializer<tag::UserNameT, tag::UserAgeT, tag::UserLangsT, tag::UserCityT> serializer;
+    char buffer[4096];
+    const auto before = heap_allocations.load();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(serializer.write(buffer, sizeof(buffer), name, 23, langs, name));
+        benchmark::ClobberMemory();
+    }
+    state.counters["heap_allocations"] = benchmark::Counter(
+        static_cast<double>(heap_allocations.load() - before), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_Serializer);
+
+// JSON Lines of log records
+const string& log_lines() {
+    static const auto text = [] {
+        string text;
+        for (int i = 0; i < 100000; ++i) {
+            text += "{\"ts\": " + std::to_string(1700000000 + i)
+                  + ", \"level\": \"info\", \"msg\": \"request " + std::to_string(i) + " done\""
+                  + ", \"user\": {\"name\": \"u" + std::to_string(i % 1000) + "\", \"age\": "
+                  + std::to_string(i % 90) + "}}\n";
+        }
+        return text;
+    }();
+    return text;
+}
+
+// the single-threaded loop of parse and read
+void BM_NdjsonParse(benchmark::State& state) {
+    const auto text = std::string_view(log_lines());
+    for (auto _ : state) {
+        std::size_t total = 0;
+        for (auto rest = text; !rest.empty();) {
+            const auto eol = rest.find('\n');
+            const auto jv = json::parse(rest.substr(0, eol));
+            total += read(jv, tag::UserName).size() + read(jv, tag::UserAge);
+            rest.remove_prefix(eol == std::string_view::npos ? rest.size() : eol + 1);
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+BENCHMARK(BM_NdjsonParse)->UseRealTime();
+
+// arg threads: the number of threads, 0 for the hardware concurrency
+void BM_NdjsonExtractor(benchmark::State& state) {
+    const auto text = std::string_view(log_lines());
+    json_access_helper::ndjson_extractor<tag::UserNameT, tag::UserAgeT> extractor(static_cast<unsigned>(state.range(0)));
+    for (auto _ : state) {
+        std::size_t total = 0;
+        extractor.extract(text, [&](std::size_t, std::tuple<string, int>&& values) {
+            total += std::get<0>(values).size() + std::get<1>(values);
+        });
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+BENCHMARK(BM_NdjsonExtractor)->ArgNames({"threads"})->Arg(1)->Arg(0)->UseRealTime();
+
+// the log lines written to a file once
+const string& log_file() {
+    static const auto path = [] {
+        string path = "json_helper_bench_log.ndjson";
+        std::ofstream(path, std::ios::binary) << log_lines();
+        return path;
+    }();
+    return path;
+}
+
+// the file is read into a string before the extraction
+void BM_NdjsonFileRead(benchmark::State& state) {
+    json_access_helper::ndjson_extractor<tag::UserNameT, tag::UserAgeT> extractor;
+    for (auto _ : state) {
+        std::ifstream in(log_file(), std::ios::binary);
+        const string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        std::size_t total = 0;
+        extractor.try_extract(text, [&](std::size_t, const auto& results) {
+            total += std::get<1>(results) ? *std::get<1>(results) : 0;
+        });
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * log_lines().size()));
+}
+BENCHMARK(BM_NdjsonFileRead)->UseRealTime();
+
+// the file is mapped
+void BM_NdjsonFileMap(benchmark::State& state) {
+    json_access_helper::ndjson_extractor<tag::UserNameT, tag::UserAgeT> extractor;
+    for (auto _ : state) {
+        const json_access_helper::mapped_file file(log_file());
+        std::size_t total = 0;
+        extractor.try_extract(file.text(), [&](std::size_t, const auto& results) {
+            total += std::get<1>(results) ? *std::get<1>(results) : 0;
+        });
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * log_lines().size()));
+}
+BENCHMARK(BM_NdjsonFileMap)->UseRealTime();
+
+// a state document of about 5 MB
+json::value make_state_document() {
+    json::value jv = json::parse(corpus());
+    auto& items = jv.as_object()["items"].as_array();
+    const auto copy = items;
+    for (int i = 0; i < 2; ++i) {
+        for (const auto& item : copy) {
+            items.push_back(item);
+        }
+    }
+    jv.as_object()["state"] = json::parse(R"({"revision": 0, "status": "ok"})");
+    return jv;
+}
+
+// the whole document is serialized after each change of 3 values
+void BM_PublishSerialize(benchmark::State& state) {
+    auto jv = make_state_document();
+    int revision = 0;
+    for (auto _ : state) {
+        ++revision;
+        write(jv, tag::Revision, revision);
+        write(jv, tag::Status, revision % 2 ? "ok" : "busy");
+        write(jv, tag::ItemId, revision);
+        benchmark::DoNotOptimize(json::serialize(jv));
+    }
+}
+BENCHMARK(BM_PublishSerialize);
+
+// only the changed values are serialized, and the text is given as segments
+void BM_PublishTracked(benchmark::State& state) {
+    json_access_helper::tracked_document doc(make_state_document());
+    // the containers on the pointers are split at the first change
+    write(doc, tag::Revision, 0);
+    write(doc, tag::ItemId, 0);
+    doc.serialize_segments();
+    int revision = 0;
+    for (auto _ : state) {
+        ++revision;
+        write(doc, tag::Revision, revision);
+        write(doc, tag::Status, revision % 2 ? "ok" : "busy");
+        write(doc, tag::ItemId, revision);
+        benchmark::DoNotOptimize(doc.serialize_segments().data());
+    }
+}
+BENCHMARK(BM_PublishTracked);
+
+// the segments are joined into a string
+void BM_PublishTrackedString(benchmark::State& state) {
+    json_access_helper::tracked_document doc(make_state_document());
+    write(doc, tag::Revision, 0);
+    write(doc, tag::ItemId, 0);
+    string text;
+    doc.serialize(text);
+    int revision = 0;
+    for (auto _ : state) {
+        ++revision;
+        write(doc, tag::Revision, revision);
+        write(doc, tag::Status, revision % 2 ? "ok" : "busy");
+        write(doc, tag::ItemId, revision);
+        doc.serialize(text);
+        benchmark::DoNotOptimize(text.data());
+    }
+}
+BENCHMARK(BM_PublishTrackedString);
+
+const vector<json::value>& log_documents() {
+    static const auto docs = [] {
+        vector<json::value> docs;
+        const auto text = std::string_view(log_lines());
+        for (std::size_t pos = 0; pos < text.size();) {
+            const auto eol = text.find('\n', pos);
+            docs.push_back(json::parse(text.substr(pos, eol - pos)));
+            pos = eol + 1;
+        }
+        return docs;
+    }();
+    return docs;
+}
+
+// the aggregation reads every document
+void BM_AggregateDocuments(benchmark::State& state) {
+    const auto& docs = log_documents();
+    for (auto _ : state) {
+        std::int64_t total = 0;
+        for (const auto& jv : docs) {
+            if (auto age = try_read(jv, tag::UserAge)) {
+                total += *age;
+            }
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * docs.size()));
+}
+BENCHMARK(BM_AggregateDocuments);
+
+// the aggregation scans a contiguous column
+void BM_AggregateColumns(benchmark::State& state) {
+    const auto table = json_access_helper::make_columns(log_documents(), tag::UserAge);
+    const auto& ages = table.column(tag::UserAge);
+    for (auto _ : state) {
+        std::int64_t total = 0;
+        for (std::size_t i = 0; i < ages.size(); ++i) {
+            total += ages.valid(i) ? ages[i] : 0;
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * ages.size()));
+}
+BENCHMARK(BM_AggregateColumns);
+
+void BM_MakeColumns(benchmark::State& state) {
+    const auto& docs = log_documents();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(json_access_helper::make_columns(docs, tag::UserName, tag::UserAge));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * docs.size()));
+}
+BENCHMARK(BM_MakeColumns);
+
+}  // namespace
+
+BENCHMARK_MAIN();
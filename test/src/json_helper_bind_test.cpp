@@ -0,0 +1,144 @@
+#include "json_access_helper_bind.hpp"
+
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <boost/json.hpp>
+#include <gtest/gtest.h>
+
+namespace json = boost::json;
+using std::string;
+using std::vector;
+
+#define MAKE_JSON_ACCESSOR DECLARE_AND_DEFINE_JSON_ACCESSOR
+
+namespace json_bind_test_impl {
+
+MAKE_JSON_ACCESSOR(User,      json::value,    "/user")
+MAKE_JSON_ACCESSOR(UserName,  string,         "/user/name")
+MAKE_JSON_ACCESSOR(UserAge,   int,            "/user/age")
+MAKE_JSON_ACCESSOR(FirstLang, string,         "/user/languages/0")
+MAKE_JSON_ACCESSOR(Nickname,  string,         "/user/nickname")
+MAKE_JSON_ACCESSOR(ItemX,     int,            "/items/x")
+
+}  // namespace json_bind_test_impl
+
+namespace {
+
+const auto template_json = json::parse(R"({
+    "id": 1,
+    "user": {
+        "name": "Alice",
+        "age": 23,
+        "languages": ["C++", "Python"]
+    }
+})");
+
+namespace tag = json_bind_test_impl;
+
+TEST(JsonBind, Read) {
+    auto jv = template_json;
+    const auto view = json_access_helper::bind(jv, tag::UserName, tag::UserAge, tag::FirstLang, tag::Nickname);
+    EXPECT_TRUE(view.valid());
+
+    EXPECT_EQ(read(view, tag::UserName),  "Alice");
+    EXPECT_EQ(read(view, tag::UserAge),   23);
+    EXPECT_EQ(read(view, tag::FirstLang), "C++");
+    EXPECT_EQ(reference(view, tag::UserAge), reference(jv, tag::UserAge));
+    // a const view does not give mutable access to the document
+    static_assert(std::is_same_v<decltype(reference(view, tag::UserAge)), const json::value*>);
+    static_assert(std::is_same_v<decltype(view.document()), const json::value&>);
+
+    EXPECT_EQ(try_read(view, tag::Nickname).error(), json::error::not_found);
+    EXPECT_ANY_THROW(read(view, tag::Nickname));
+}
+
+TEST(JsonBind, Write) {
+    auto jv = template_json;
+    auto view = json_access_helper::bind(jv, tag::UserName, tag::UserAge, tag::Nickname);
+
+    EXPECT_TRUE(write(view, tag::UserName, "Bob"));
+    EXPECT_TRUE(write(view, tag::UserAge, 30));
+    EXPECT_FALSE(write(view, tag::Nickname, "B"));
+    EXPECT_EQ(read(jv, tag::UserName), "Bob");
+    EXPECT_EQ(read(jv, tag::UserAge),  30);
+}
+
+TEST(JsonBind, ConstDocument) {
+    const auto jv = template_json;
+    const auto view = json_access_helper::bind(jv, tag::UserName, tag::UserAge);
+    static_assert(std::is_same_v<std::decay_t<decltype(view)>,
+                                 json_access_helper::const_bound_view<tag::UserNameT, tag::UserAgeT>>);
+
+    EXPECT_EQ(read(view, tag::UserName), "Alice");
+    EXPECT_EQ(reference(view, tag::UserAge), reference(jv, tag::UserAge));
+    static_assert(std::is_same_v<decltype(reference(view, tag::UserAge)), const json::value*>);
+
+    auto copy = view;
+    static_assert(std::is_same_v<decltype(reference(copy, tag::UserAge)), const json::value*>);
+    static_assert(std::is_same_v<decltype(copy.document()), const json::value&>);
+}
+
+TEST(JsonBind, Rebind) {
+    auto jv = template_json;
+    auto view = json_access_helper::bind(jv, tag::UserName, tag::UserAge, tag::FirstLang);
+    EXPECT_TRUE(view.valid());
+
+    // a change made directly needs rebind()
+    jv.at("user").as_object().erase("name");
+    view.rebind();
+    EXPECT_EQ(read(view, tag::UserAge), 23);
+    EXPECT_EQ(try_read(view, tag::UserName).error(), json::error::not_found);
+
+    jv.at("user").as_object()["name"] = "Carol";
+    view.rebind();
+    EXPECT_EQ(read(view, tag::UserName), "Carol");
+    EXPECT_EQ(reference(view, tag::UserName), reference(jv, tag::UserName));
+
+    jv.at("user") = json::parse(R"({"languages": ["Rust"], "age": 40, "name": "Dave"})");
+    view.rebind();
+    EXPECT_EQ(read(view, tag::FirstLang), "Rust");
+    EXPECT_EQ(read(view, tag::UserAge),   40);
+    EXPECT_EQ(read(view, tag::UserName),  "Dave");
+
+    view.document() = 1;
+    view.rebind();
+    EXPECT_EQ(try_read(view, tag::UserName).error(), json::error::value_is_scalar);
+}
+
+TEST(JsonBind, WriteContainer) {
+    auto jv = template_json;
+    auto view = json_access_helper::bind(jv, tag::User, tag::UserName, tag::FirstLang);
+
+    // a write of a value containing other tags starts a new generation
+    EXPECT_TRUE(write(view, tag::UserName, "Bob"));
+    EXPECT_TRUE(view.valid());
+    EXPECT_TRUE(write(view, tag::User, json::parse(R"({"languages": ["Go"], "name": "Eve"})")));
+    EXPECT_FALSE(view.valid());
+    const auto& const_view = view;
+    EXPECT_EQ(read(const_view, tag::UserName), "Eve");  // normal lookup
+    EXPECT_FALSE(view.valid());
+    EXPECT_EQ(read(view, tag::UserName),  "Eve");       // resolves the table again
+    EXPECT_TRUE(view.valid());
+    EXPECT_EQ(read(view, tag::FirstLang), "Go");
+
+    // so does a reference to it
+    reference(view, tag::User)->as_object().erase("name");
+    EXPECT_FALSE(view.valid());
+    EXPECT_EQ(try_read(view, tag::UserName).error(), json::error::not_found);
+    EXPECT_EQ(read(view, tag::FirstLang), "Go");
+}
+
+TEST(JsonBind, ObjectToArray) {
+    auto jv = json::parse(R"({"items": {"x": 1}})");
+    auto view = json_access_helper::bind(jv, tag::ItemX);
+    EXPECT_EQ(read(view, tag::ItemX), 1);
+
+    // a member of an object is not an element of the array that replaced it
+    jv.at("items") = json::array{5};
+    view.rebind();
+    EXPECT_EQ(try_read(view, tag::ItemX).error(), json::error::token_not_number);
+}
+
+}  // namespace
@@ -0,0 +1,104 @@
+#include "json_access_helper_bundle.hpp"
+
+#include <string>
+#include <vector>
+
+#include <boost/json.hpp>
+#include <gtest/gtest.h>
+
+namespace json = boost::json;
+using std::string;
+using std::vector;
+
+#define MAKE_JSON_ACCESSOR DECLARE_AND_DEFINE_JSON_ACCESSOR
+
+namespace json_bundle_test_impl {
+
+MAKE_JSON_ACCESSOR(UserName,  string,         "/user/name")
+MAKE_JSON_ACCESSOR(UserAge,   int,            "/user/age")
+MAKE_JSON_ACCESSOR(UserLangs, vector<string>, "/user/languages")
+MAKE_JSON_ACCESSOR(FirstLang, string,         "/user/languages/0")
+MAKE_JSON_ACCESSOR(Id,        int,            "/id")
+MAKE_JSON_ACCESSOR(Item2,     int,            "/items/2")
+MAKE_JSON_ACCESSOR(Item0,     int,            "/items/0")
+MAKE_JSON_ACCESSOR(Item1,     int,            "/items/1")
+MAKE_JSON_ACCESSOR(NewItem,   int,            "/items/-")
+MAKE_JSON_ACCESSOR(ExtraGap,  int,            "/user/extra/list/3")
+
+DEFINE_JSON_ACCESSOR_BUNDLE(User, UserName, UserAge, Id, UserLangs)
+DEFINE_JSON_ACCESSOR_BUNDLE(Items, Item1, Item0, NewItem, Item2)
+DEFINE_JSON_ACCESSOR_BUNDLE(Gap, Id, ExtraGap, UserName)
+
+}  // namespace json_bundle_test_impl
+
+namespace {
+
+const auto template_json = json::value {
+    {"id", 7},
+    {"user", {
+        {"name", "Alice"},
+        {"age",  23},
+        {"languages", json::array{"C++", "Python", "Haskell", "Rust"}},
+    }},
+};
+
+namespace tag = json_bundle_test_impl;
+
+TEST(JsonBundle, Decode) {
+    auto user = tag::User::decode(template_json);
+    EXPECT_EQ(user.UserName,  "Alice");
+    EXPECT_EQ(user.UserAge,   23);
+    EXPECT_EQ(user.Id,        7);
+    EXPECT_EQ(user.UserLangs, read(template_json, tag::UserLangs));
+
+    // throws exception if any error occurs
+    EXPECT_ANY_THROW(tag::User::decode(json::value()));
+    EXPECT_ANY_THROW(tag::User::decode(json::value{{"id", "7"}, {"user", template_json.at("user")}}));
+}
+
+TEST(JsonBundle, TryDecode) {
+    auto user = tag::User::try_decode(template_json);
+    EXPECT_TRUE(user);
+    EXPECT_EQ(user->UserName, "Alice");
+
+    // reports the first error in the order of the members
+    auto missing = json::value{{"user", {{"name", 1}}}};
+    EXPECT_EQ(tag::User::try_decode(missing).error(), try_read(missing, tag::UserName).error());
+    EXPECT_EQ(tag::User::try_decode(json::value{{"user", 1}}).error(), json::error::value_is_scalar);
+}
+
+TEST(JsonBundle, Encode) {
+    // same document as the accessors
+    auto user = tag::User::decode(template_json);
+    auto json_1 = json::value();
+    encode(user, json_1);
+    EXPECT_EQ(json_1, template_json);
+
+    // overwrites the existing values
+    user.UserAge = 24;
+    user.UserLangs = {"Go"};
+    encode(user, json_1);
+    EXPECT_EQ(read(json_1, tag::UserAge),   24);
+    EXPECT_EQ(read(json_1, tag::UserLangs), vector<string>{"Go"});
+
+    // the array elements are emplaced in index order, and "-" appends a new element each time
+    auto json_2 = json::value();
+    encode(tag::Items{1, 0, 3, 2}, json_2);
+    EXPECT_EQ(json_2, (json::value{{"items", {0, 1, 2, 3}}}));
+}
+
+TEST(JsonBundle, EncodeFailsPartWay) {
+    // "/user/extra/list/3" creates "extra" and "list" before the index gap, and they are
+    // removed again. "/id" before it stays written and "/user/name" after it is not reached
+    auto jv = template_json;
+    EXPECT_THROW(encode(tag::Gap{8, 1, "Bob"}, jv), boost::system::system_error);
+    auto expected = template_json;
+    expected.at("id") = 8;
+    EXPECT_EQ(jv, expected);
+
+    json::value null_jv;
+    EXPECT_THROW(encode(tag::Gap{8, 1, "Bob"}, null_jv), boost::system::system_error);
+    EXPECT_EQ(null_jv, (json::value{{"id", 8}}));
+}
+
+}  // namespace
@@ -0,0 +1,147 @@
+#include "json_access_helper_columnar.hpp"
+
+#include <cstdint>
+#include <list>
+#include <string>
+#include <vector>
+
+#include <boost/json.hpp>
+#include <gtest/gtest.h>
+
+namespace json = boost::json;
+using std::string;
+using std::vector;
+
+#define MAKE_JSON_ACCESSOR DECLARE_AND_DEFINE_JSON_ACCESSOR
+
+namespace json_columnar_test_impl {
+
+MAKE_JSON_ACCESSOR(UserName,  string,       "/user/name")
+MAKE_JSON_ACCESSOR(UserAge,   std::int32_t, "/user/age")
+MAKE_JSON_ACCESSOR(UserScore, double,       "/user/score")
+MAKE_JSON_ACCESSOR(Admin,     bool,         "/user/admin")
+
+}  // namespace json_columnar_test_impl
+
+namespace {
+
+namespace tag = json_columnar_test_impl;
+
+const string template_lines =
+    R"({"user": {"name": "Alice", "age": 23, "score": 1.5, "admin": true}})" "\n"
+    R"({"user": {"name": null, "age": "x", "admin": false}})" "\n"
+    "\n"
+    R"({"user": {"name": "Bob", "age": 31, "score": 2}})" "\n";
+
+TEST(JsonColumnar, Documents) {
+    vector<json::value> docs;
+    for (const auto* line : {R"({"user": {"name": "Alice", "age": 23, "score": 1.5, "admin": true}})",
+                             R"({"user": {"name": null, "age": "x", "admin": false}})",
+                             R"({"user": {"name": "Bob", "age": 31, "score": 2}})"}) {
+        docs.push_back(json::parse(line));
+    }
+    const auto table = json_access_helper::make_columns(docs, tag::UserName, tag::UserAge, tag::UserScore, tag::Admin);
+    ASSERT_EQ(table.size(), 3u);
+
+    const auto& ages = table.column(tag::UserAge);
+    EXPECT_EQ(ages.values(), (vector<std::int32_t>{23, 0, 31}));
+    EXPECT_TRUE(ages.valid(0));
+    EXPECT_FALSE(ages.valid(1));
+    EXPECT_EQ(ages.validity().null_count(), 1u);
+    EXPECT_EQ(ages.validity().words(), vector<std::uint64_t>{0b101});
+
+    const auto& names = table.column(tag::UserName);
+    EXPECT_EQ(names.bytes(), "AliceBob");
+    EXPECT_EQ(names.offsets(), (vector<std::size_t>{0, 5, 5, 8}));
+    EXPECT_EQ(names[2], "Bob");
+    EXPECT_FALSE(names.valid(1));
+
+    const auto& scores = table.column(tag::UserScore);
+    EXPECT_EQ(scores[0], 1.5);
+    EXPECT_EQ(scores[2], 2.0);
+    EXPECT_FALSE(scores.valid(1));
+
+    const auto& admins = table.column(tag::Admin);
+    EXPECT_TRUE(admins[0]);
+    EXPECT_FALSE(admins[1]);
+    EXPECT_TRUE(admins.valid(1));
+    EXPECT_FALSE(admins.valid(2));
+
+    // any range of documents
+    const std::list<json::value> list(docs.begin(), docs.end());
+    EXPECT_EQ(json_access_helper::make_columns(list, tag::UserAge).column(tag::UserAge).values(), ages.values());
+}
+
+TEST(JsonColumnar, Lines) {
+    const auto table = json_access_helper::make_columns(template_lines, tag::UserName, tag::UserAge);
+    ASSERT_EQ(table.size(), 3u);
+    EXPECT_EQ(table.column(tag::UserName).bytes(),   "AliceBob");
+    EXPECT_EQ(table.column(tag::UserAge).values(),   (vector<std::int32_t>{23, 0, 31}));
+    EXPECT_EQ(table.column(tag::UserAge).validity().null_count(), 1u);
+
+    // more than a word of the bitmap
+    json_access_helper::column_table<tag::UserAgeT> ages;
+    for (int i = 0; i < 130; ++i) {
+        ages.append(i % 3 == 0 ? json::parse(R"({"user": {"age": 1}})") : json::value());
+    }
+    EXPECT_EQ(ages.size(), 130u);
+    EXPECT_EQ(ages.column(tag::UserAge).validity().words().size(), 3u);
+    EXPECT_EQ(ages.column(tag::UserAge).validity().null_count(), 86u);
+    EXPECT_TRUE(ages.column(tag::UserAge).valid(129));
+    EXPECT_FALSE(ages.column(tag::UserAge).valid(128));
+}
+
+TEST(JsonColumnar, Extractor) {
+    // the strings with escapes are extracted again from their lines
+    const string lines =
+        R"({"user": {"name": "A\"l", "age": 1}})" "\n"
+        "\n"
+        R"({"user": {"name": "Bob", "age": 2}})" "\n"
+        R"({"user": {"name": "C\u0061rol", "age": 3}})" "\n"
+        R"({"user": {"name": 4}})";
+
+    json_access_helper::column_extractor<tag::UserNameT, tag::UserAgeT> extractor(2);
+    for (int i = 0; i < 2; ++i) {
+        const auto table = json_access_helper::make_columns(lines, extractor, tag::UserName, tag::UserAge);
+        ASSERT_EQ(table.size(), 4u);
+        const auto& names = table.column(tag::UserName);
+        EXPECT_EQ(names.bytes(), "A\"lBobCarol");
+        EXPECT_EQ(names[0], "A\"l");
+        EXPECT_EQ(names[2], "Carol");
+        EXPECT_FALSE(names.valid(3));
+        EXPECT_EQ(table.column(tag::UserAge).values(), (vector<std::int32_t>{1, 2, 3, 0}));
+    }
+}
+
+TEST(JsonColumnar, ExtractorContainers) {
+    // arrays and objects are captured by the reused extractors and become nulls
+    string lines;
+    for (int i = 0; i < 1000; ++i) {
+        const auto n = std::to_string(i);
+        if (i % 3 == 0) {
+            lines += R"({"user": {"name": ["a", ")" + n + R"("], "age": {"years": )" + n + "}}}\n";
+        } else {
+            lines += R"({"user": {"name": "u)" + n + R"(", "age": )" + n + "}}\n";
+        }
+    }
+
+    json_access_helper::column_extractor<tag::UserNameT, tag::UserAgeT> extractor(4);
+    for (int run = 0; run < 3; ++run) {
+        const auto table = json_access_helper::make_columns(lines, extractor, tag::UserName, tag::UserAge);
+        ASSERT_EQ(table.size(), 1000u);
+        const auto& names = table.column(tag::UserName);
+        const auto& ages = table.column(tag::UserAge);
+        EXPECT_EQ(names.validity().null_count(), 334u);
+        EXPECT_EQ(ages.validity().null_count(), 334u);
+        for (int i = 0; i < 1000; ++i) {
+            ASSERT_EQ(names.valid(i), i % 3 != 0);
+            ASSERT_EQ(ages.valid(i), i % 3 != 0);
+            if (i % 3 != 0) {
+                EXPECT_EQ(names[i], "u" + std::to_string(i));
+                EXPECT_EQ(ages.values()[i], i);
+            }
+        }
+    }
+}
+
+}  // namespace
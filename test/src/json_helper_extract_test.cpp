@@ -0,0 +1,144 @@
+#include "json_access_helper_extract.hpp"
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <boost/json.hpp>
+#include <gtest/gtest.h>
+
+namespace json = boost::json;
+using std::string;
+using std::vector;
+
+using score_map = std::map<string, int>;
+
+#define MAKE_JSON_ACCESSOR DECLARE_AND_DEFINE_JSON_ACCESSOR
+
+namespace json_extract_test_impl {
+
+MAKE_JSON_ACCESSOR(UserName,  string,         "/user/name")
+MAKE_JSON_ACCESSOR(UserAge,   int,            "/user/age")
+MAKE_JSON_ACCESSOR(UserLangs, vector<string>, "/user/languages")
+MAKE_JSON_ACCESSOR(FirstLang, string,         "/user/languages/0")
+MAKE_JSON_ACCESSOR(LastLang,  string,         "/user/languages/-")
+MAKE_JSON_ACCESSOR(Nickname,  string,         "/user/nickname")
+MAKE_JSON_ACCESSOR(NameChar,  string,         "/user/name/0")
+MAKE_JSON_ACCESSOR(Scores,    score_map,      "/scores")
+MAKE_JSON_ACCESSOR(User,      json::value,    "/user")
+MAKE_JSON_ACCESSOR(UserNameJ, json::string,   "/user/name")
+
+}  // namespace json_extract_test_impl
+
+namespace {
+
+const auto template_text = std::string(R"({
+    "id": 1,
+    "history": [{"a": [1, 2, {"b": "c"}]}, "x\"y", 3.5, null, true],
+    "user": {
+        "name": "Alice",
+        "age": 23,
+        "languages": ["C++", "Python", "Haskell", "Rust"]
+    },
+    "trailer": {"ignored": [1, 2, 3]}
+})");
+
+namespace tag = json_extract_test_impl;
+
+TEST(JsonExtract, Extract) {
+    auto [name, age, langs, first] = json_access_helper::extract(
+        template_text, tag::UserName, tag::UserAge, tag::UserLangs, tag::FirstLang);
+
+    EXPECT_EQ(name,  "Alice");
+    EXPECT_EQ(age,   23);
+    EXPECT_EQ(langs, (vector<string>{"C++", "Python", "Haskell", "Rust"}));
+    EXPECT_EQ(first, "C++");
+
+    // throws exception if any error occurs
+    EXPECT_ANY_THROW(json_access_helper::extract(template_text, tag::UserName, tag::Nickname));
+    EXPECT_ANY_THROW(json_access_helper::extract("{\"user\": ", tag::UserName));
+}
+
+TEST(JsonExtract, TryExtract) {
+    auto [name, nickname, last, name_char] = json_access_helper::try_extract(
+        template_text, tag::UserName, tag::Nickname, tag::LastLang, tag::NameChar);
+
+    EXPECT_TRUE(name);
+    EXPECT_EQ(*name, "Alice");
+    EXPECT_EQ(nickname.error(),  json::error::not_found);
+    EXPECT_EQ(last.error(),      json::error::past_the_end);
+    EXPECT_EQ(name_char.error(), json::error::value_is_scalar);
+
+    // the errors of the parser are reported for the tags not resolved yet
+    auto [age] = json_access_helper::try_extract("{\"user\": {\"age\": 23,", tag::UserAge);
+    EXPECT_TRUE(age);
+    auto [langs] = json_access_helper::try_extract("{\"user\": {\"age\": 23,", tag::UserLangs);
+    EXPECT_FALSE(langs);
+    auto [extra] = json_access_helper::try_extract("{} {}", tag::UserLangs);
+    EXPECT_EQ(extra.error(), json::error::extra_data);
+}
+
+TEST(JsonExtract, TrailingData) {
+    // the text after the document is checked unless every tag was resolved inside it.
+    // "/scores" is resolved only at the end of the root object
+    auto [age, scores] = json_access_helper::try_extract("{\"id\": 1, \"user\": {\"age\": 23}} x",
+                                                         tag::UserAge, tag::Scores);
+    EXPECT_EQ(age.error(),    json::error::extra_data);
+    EXPECT_EQ(scores.error(), json::error::extra_data);
+    EXPECT_ANY_THROW(json_access_helper::extract("{\"user\": {\"age\": 23}}]", tag::UserAge, tag::Scores));
+
+    auto [spaces] = json_access_helper::try_extract("{\"id\": 1} \r\n\t ", tag::UserAge);
+    EXPECT_EQ(spaces.error(), json::error::not_found);
+    auto [scalar] = json_access_helper::try_extract("1 2", tag::UserAge);
+    EXPECT_EQ(scalar.error(), json::error::extra_data);
+
+    // parsing stopped before the text
+    auto [early] = json_access_helper::try_extract("{\"user\": {\"age\": 23}} x", tag::UserAge);
+    EXPECT_EQ(*early, 23);
+}
+
+TEST(JsonExtract, Extractor) {
+    json_access_helper::extractor<tag::UserAgeT, tag::FirstLangT> extractor;
+
+    // same results as the accessors on the parsed document
+    for (int i = 0; i < 3; ++i) {
+        auto text = "{\"user\": {\"languages\": [\"Lang" + std::to_string(i) + "\"], \"age\": " + std::to_string(i) + "}}";
+        auto jv = json::parse(text);
+        auto [age, first] = extractor.extract(text);
+        EXPECT_EQ(age,   read(jv, tag::UserAge));
+        EXPECT_EQ(first, read(jv, tag::FirstLang));
+    }
+}
+
+TEST(JsonExtract, ExtractorJsonResult) {
+    json_access_helper::extractor<tag::UserT, tag::UserNameJT> extractor;
+
+    // the results are on the default resource, not on the extractor's buffer
+    auto [user, name] = extractor.extract(R"({"user":{"name":"Alice","languages":["C++"]}})");
+    extractor.extract(R"({"user":{"name":"Bob","languages":["Go","Rust"]}})");
+    EXPECT_EQ(user, json::parse(R"({"name":"Alice","languages":["C++"]})"));
+    EXPECT_EQ(name, "Alice");
+    EXPECT_EQ(user.storage(), json::storage_ptr());
+    EXPECT_EQ(name.storage(), json::storage_ptr());
+}
+
+TEST(JsonExtract, ExtractorCapture) {
+    json_access_helper::extractor<tag::UserLangsT, tag::ScoresT> extractor;
+
+    // the arrays and objects are built on the extractor's buffer again for each call, and
+    // outgrow it
+    for (int i = 1; i <= 5; ++i) {
+        json::array langs;
+        json::object scores;
+        for (int j = 0; j < i * 40; ++j) {
+            langs.emplace_back(string(40, static_cast<char>('a' + (i + j) % 26)));
+            scores["key" + std::to_string(j)] = i * j;
+        }
+        const auto jv = json::value{{"user", {{"languages", langs}}}, {"scores", scores}};
+        auto [l, sc] = extractor.extract(json::serialize(jv));
+        EXPECT_EQ(l,  read(jv, tag::UserLangs));
+        EXPECT_EQ(sc, read(jv, tag::Scores));
+    }
+}
+
+}  // namespace
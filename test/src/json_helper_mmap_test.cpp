@@ -0,0 +1,106 @@
+#include "json_access_helper_mmap.hpp"
+#include "json_access_helper_extract.hpp"
+#include "json_access_helper_ndjson.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <boost/json.hpp>
+#include <gtest/gtest.h>
+
+namespace json = boost::json;
+using std::string;
+using std::string_view;
+using std::vector;
+
+#define MAKE_JSON_ACCESSOR DECLARE_AND_DEFINE_JSON_ACCESSOR
+
+namespace json_mmap_test_impl {
+
+MAKE_JSON_ACCESSOR(UserName, string_view,    "/user/name")
+MAKE_JSON_ACCESSOR(UserAge,  int,            "/user/age")
+MAKE_JSON_ACCESSOR(UserTags, vector<string>, "/user/tags")
+
+}  // namespace json_mmap_test_impl
+
+namespace {
+
+namespace tag = json_mmap_test_impl;
+
+// a file removed at the end of the test
+class temp_file {
+public:
+    explicit temp_file(string_view text) : path_(testing::TempDir() + "json_helper_mmap_test.json") {
+        std::ofstream(path_, std::ios::binary) << text;
+    }
+
+    ~temp_file() {
+        std::remove(path_.c_str());
+    }
+
+    const string& path() const noexcept {
+        return path_;
+    }
+
+private:
+    string path_;
+};
+
+bool refers_to(string_view text, string_view view) {
+    return text.data() <= view.data() && view.data() + view.size() <= text.data() + text.size();
+}
+
+TEST(JsonMmap, Extract) {
+    const temp_file file(R"({"user": {"name": "Alice", "age": 23, "tags": ["a", "b"]}})");
+    const json_access_helper::mapped_file mapped(file.path());
+    ASSERT_EQ(mapped.text(), R"({"user": {"name": "Alice", "age": 23, "tags": ["a", "b"]}})");
+
+    auto [name, age, tags] = json_access_helper::extract(mapped.text(), tag::UserName, tag::UserAge, tag::UserTags);
+    EXPECT_EQ(name, "Alice");
+    EXPECT_TRUE(refers_to(mapped.text(), name));
+    EXPECT_EQ(age,  23);
+    EXPECT_EQ(tags, (vector<string>{"a", "b"}));
+
+    // an escaped string is not in the text
+    auto [escaped] = json_access_helper::try_extract(R"({"user": {"name": "A\"B"}})", tag::UserName);
+    EXPECT_EQ(escaped.error(), json::error::not_exact);
+
+    auto moved = json_access_helper::mapped_file(file.path(), {false, false, true});
+    EXPECT_EQ(moved.text(), mapped.text());
+    moved = json_access_helper::mapped_file();
+    EXPECT_TRUE(moved.text().empty());
+}
+
+TEST(JsonMmap, Lines) {
+    string text;
+    for (int i = 0; i < 1000; ++i) {
+        text += R"({"user": {"name": "u)" + std::to_string(i) + R"(", "age": )" + std::to_string(i) + "}}\n";
+    }
+    const temp_file file(text);
+    const json_access_helper::mapped_file mapped(file.path());
+
+    json_access_helper::ndjson_extractor<tag::UserNameT, tag::UserAgeT> extractor(2, {}, 512);
+    std::size_t n = 0;
+    extractor.extract(mapped.text(), [&](std::size_t line, std::tuple<string_view, int>&& values) {
+        EXPECT_EQ(std::get<0>(values), "u" + std::to_string(line));
+        EXPECT_TRUE(refers_to(mapped.text(), std::get<0>(values)));
+        EXPECT_EQ(std::get<1>(values), static_cast<int>(line));
+        ++n;
+    });
+    EXPECT_EQ(n, 1000u);
+}
+
+TEST(JsonMmap, Error) {
+    EXPECT_THROW(json_access_helper::mapped_file(testing::TempDir() + "json_helper_mmap_test_missing.json"),
+                 boost::system::system_error);
+
+    const temp_file empty("");
+    const json_access_helper::mapped_file mapped(empty.path());
+    EXPECT_EQ(mapped.size(), 0u);
+    EXPECT_TRUE(mapped.text().empty());
+}
+
+}  // namespace
@@ -0,0 +1,118 @@
+#include "json_access_helper_ndjson.hpp"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <boost/json.hpp>
+#include <gtest/gtest.h>
+
+namespace json = boost::json;
+using std::string;
+using std::vector;
+
+#define MAKE_JSON_ACCESSOR DECLARE_AND_DEFINE_JSON_ACCESSOR
+
+namespace json_ndjson_test_impl {
+
+MAKE_JSON_ACCESSOR(UserName, string,         "/user/name")
+MAKE_JSON_ACCESSOR(UserAge,  int,            "/user/age")
+MAKE_JSON_ACCESSOR(Langs,    vector<string>, "/user/languages")
+MAKE_JSON_ACCESSOR(Scores,   json::value,    "/scores")
+
+}  // namespace json_ndjson_test_impl
+
+namespace {
+
+namespace tag = json_ndjson_test_impl;
+
+using extractor = json_access_helper::ndjson_extractor<tag::UserNameT, tag::UserAgeT>;
+
+string make_lines(std::size_t n) {
+    string text;
+    for (std::size_t i = 0; i < n; ++i) {
+        text += R"({"id": )" + std::to_string(i) + R"(, "user": {"name": "u)" + std::to_string(i)
+            + R"(", "age": )" + std::to_string(i % 100) + "}}\n";
+    }
+    return text;
+}
+
+TEST(JsonNdjson, Order) {
+    const auto text = make_lines(5000);
+    for (unsigned threads : {1u, 4u}) {
+        // small batches so that the workers steal from each other
+        extractor ext(threads, {}, 256);
+        EXPECT_EQ(ext.threads(), threads);
+
+        std::size_t next = 0;
+        ext.extract(text, [&](std::size_t line, std::tuple<string, int>&& values) {
+            EXPECT_EQ(line, next++);
+            EXPECT_EQ(std::get<0>(values), "u" + std::to_string(line));
+            EXPECT_EQ(std::get<1>(values), static_cast<int>(line % 100));
+        });
+        EXPECT_EQ(next, 5000u);
+
+        // the pool is reused
+        next = 0;
+        ext.extract(text.substr(0, 1000), [&](std::size_t line, auto&&) { EXPECT_EQ(line, next++); });
+        EXPECT_GT(next, 0u);
+    }
+}
+
+TEST(JsonNdjson, Containers) {
+    string text;
+    for (std::size_t i = 0; i < 2000; ++i) {
+        json::array langs;
+        json::object scores;
+        for (std::size_t j = 0; j < i % 7; ++j) {
+            langs.emplace_back("lang" + std::to_string(i + j));
+            scores["s" + std::to_string(j)] = i * j;
+        }
+        text += json::serialize(json::value{{"user", {{"languages", langs}}}, {"scores", scores}}) + "\n";
+    }
+
+    // each worker reuses its extractor for many lines, and the results of a batch are kept
+    // until the batch is delivered
+    json_access_helper::ndjson_extractor<tag::LangsT, tag::ScoresT> ext(4, {}, 512);
+    std::size_t next = 0;
+    ext.extract(text, [&](std::size_t line, std::tuple<vector<string>, json::value>&& values) {
+        EXPECT_EQ(line, next++);
+        auto& [langs, scores] = values;
+        ASSERT_EQ(langs.size(), line % 7);
+        ASSERT_EQ(scores.as_object().size(), line % 7);
+        for (std::size_t j = 0; j < line % 7; ++j) {
+            EXPECT_EQ(langs[j], "lang" + std::to_string(line + j));
+            EXPECT_EQ(scores.at("s" + std::to_string(j)), json::value(line * j));
+        }
+    });
+    EXPECT_EQ(next, 2000u);
+}
+
+TEST(JsonNdjson, Error) {
+    const string text =
+        "{\"user\": {\"name\": \"Alice\", \"age\": 23}}\n"
+        "\n"
+        "  \r\n"
+        "{\"user\": {\"name\": \"Bob\"}}\r\n"
+        "{\"user\": \n"
+        "{\"user\": {\"name\": \"Carol\", \"age\": 40}}";
+
+    extractor ext(2, {}, 16);
+    vector<std::size_t> lines;
+    vector<bool> ages;
+    ext.try_extract(text, [&](std::size_t line, extractor::result_type&& results) {
+        lines.push_back(line);
+        ages.push_back(static_cast<bool>(std::get<1>(results)));
+    });
+    EXPECT_EQ(lines, (vector<std::size_t>{0, 3, 4, 5}));
+    EXPECT_EQ(ages,  (vector<bool>{true, false, false, true}));
+
+    // throws at the first error after the lines before it
+    vector<string> names;
+    EXPECT_ANY_THROW(ext.extract(text, [&](std::size_t, std::tuple<string, int>&& values) {
+        names.push_back(std::get<0>(values));
+    }));
+    EXPECT_EQ(names, vector<string>{"Alice"});
+}
+
+}  // namespace
@@ -0,0 +1,85 @@
+#include "json_access_helper_param.hpp"
+
+#include <string>
+#include <vector>
+
+#include <boost/json.hpp>
+#include <gtest/gtest.h>
+
+namespace json = boost::json;
+using std::string;
+using std::vector;
+
+namespace json_param_test_impl {
+
+DEFINE_JSON_PARAM_ACCESSOR(UserName,    string,         "/users/{}/name")
+DEFINE_JSON_PARAM_ACCESSOR(UserLangs,   vector<string>, "/users/{}/languages")
+DEFINE_JSON_PARAM_ACCESSOR(MemberAge,   int,            "/groups/{}/members/{}/age")
+DEFINE_JSON_PARAM_ACCESSOR(Setting,     string,         "/settings/{}")
+
+}  // namespace json_param_test_impl
+
+namespace {
+
+const auto template_json = json::parse(R"({
+    "users": [
+        {"name": "Alice", "languages": ["C++"]},
+        {"name": "Bob", "languages": []}
+    ],
+    "groups": {
+        "dev": {"members": [{"age": 23}, {"age": 31}]},
+        "7": {"members": [{"age": 40}]}
+    },
+    "settings": {"theme": "dark", "a/b": "x"}
+})");
+
+namespace tag = json_param_test_impl;
+
+TEST(JsonParam, Read) {
+    const auto& jv = template_json;
+    EXPECT_EQ(read(jv, tag::UserName(0)),  "Alice");
+    EXPECT_EQ(read(jv, tag::UserName(1u)), "Bob");
+    EXPECT_EQ(read(jv, tag::UserLangs(0)), vector<string>{"C++"});
+
+    // the arguments are substituted in order
+    EXPECT_EQ(read(jv, tag::MemberAge("dev", 1)), 31);
+    EXPECT_EQ(read(jv, tag::MemberAge(7, 0)),     40);
+
+    // a string is a key without escapes
+    string key = "a/b";
+    EXPECT_EQ(read(jv, tag::Setting(key)),     "x");
+    EXPECT_EQ(read(jv, tag::Setting("theme")), "dark");
+
+    vector<string> names;
+    for (std::size_t i = 0; i < jv.at("users").as_array().size(); ++i) {
+        names.push_back(read(jv, tag::UserName(i)));
+    }
+    EXPECT_EQ(names, (vector<string>{"Alice", "Bob"}));
+}
+
+TEST(JsonParam, TryRead) {
+    const auto& jv = template_json;
+    EXPECT_EQ(try_read(jv, tag::UserName(2)).error(),       json::error::not_found);
+    EXPECT_EQ(try_read(jv, tag::UserName(-1)).error(),      json::error::token_not_number);
+    EXPECT_EQ(try_read(jv, tag::UserName("-")).error(),     json::error::past_the_end);
+    EXPECT_EQ(try_read(jv, tag::MemberAge("qa", 0)).error(), json::error::not_found);
+    EXPECT_EQ(*try_read(jv, tag::UserName("1")), "Bob");
+    EXPECT_ANY_THROW(read(jv, tag::UserName(5)));
+}
+
+TEST(JsonParam, Write) {
+    auto jv = template_json;
+    EXPECT_TRUE(write(jv, tag::UserName(1), "Carol"));
+    EXPECT_FALSE(write(jv, tag::UserName(2), "Dave"));
+    EXPECT_EQ(read(jv, tag::UserName(1)), "Carol");
+
+    emplace(jv, tag::UserName("-"), "Dave");
+    emplace(jv, tag::MemberAge("qa", 0), 50);
+    EXPECT_EQ(read(jv, tag::UserName(2)),        "Dave");
+    EXPECT_EQ(read(jv, tag::MemberAge("qa", 0)), 50);
+
+    EXPECT_EQ(reference(jv, tag::Setting("theme")), &jv.at("settings").at("theme"));
+    EXPECT_FALSE(reference(template_json, tag::Setting("font")));
+}
+
+}  // namespace
@@ -0,0 +1,98 @@
+#include "json_access_helper_serialize.hpp"
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <boost/json.hpp>
+#include <gtest/gtest.h>
+
+namespace json = boost::json;
+using std::string;
+using std::vector;
+
+#define MAKE_JSON_ACCESSOR DECLARE_AND_DEFINE_JSON_ACCESSOR
+
+namespace json_serialize_test_impl {
+
+using score_map = std::map<string, int>;
+
+MAKE_JSON_ACCESSOR(Id,        int,            "/id")
+MAKE_JSON_ACCESSOR(UserName,  string,         "/user/name")
+MAKE_JSON_ACCESSOR(UserAge,   int,            "/user/age")
+MAKE_JSON_ACCESSOR(UserLangs, vector<string>, "/user/languages")
+MAKE_JSON_ACCESSOR(UserCity,  string,         "/user/address/city")
+MAKE_JSON_ACCESSOR(Scores,    score_map,      "/scores")
+MAKE_JSON_ACCESSOR(Ratio,     double,         "/ratio")
+MAKE_JSON_ACCESSOR(Active,    bool,           "/active")
+MAKE_JSON_ACCESSOR(Escaped,   string,         "/a~1b/\"q\"")
+MAKE_JSON_ACCESSOR(Item0,     int,            "/items/0")
+MAKE_JSON_ACCESSOR(Item1,     int,            "/items/1")
+MAKE_JSON_ACCESSOR(NewItem,   string,         "/items/-")
+MAKE_JSON_ACCESSOR(Root,      string,         "")
+
+}  // namespace json_serialize_test_impl
+
+namespace {
+
+namespace tag = json_serialize_test_impl;
+
+TEST(JsonSerialize, Write) {
+    json_access_helper::serializer<tag::UserNameT, tag::IdT, tag::UserAgeT, tag::UserCityT> serializer;
+    auto text = serializer.write("Al\"ice\n", 1, 23, "Tokyo");
+
+    // the members are written in the order of the pointers
+    EXPECT_EQ(text, R"({"id":1,"user":{"address":{"city":"Tokyo"},"age":23,"name":"Al\"ice\n"}})");
+
+    // same document as emplacing the values
+    json::value jv;
+    emplace(jv, tag::UserName, "Al\"ice\n");
+    emplace(jv, tag::Id, 1);
+    emplace(jv, tag::UserAge, 23);
+    emplace(jv, tag::UserCity, "Tokyo");
+    EXPECT_EQ(json::parse(text), jv);
+
+    // appends to the string
+    string out = "> ";
+    serializer.write(out, "Bob", 2, 30, "Osaka");
+    EXPECT_EQ(out, R"(> {"id":2,"user":{"address":{"city":"Osaka"},"age":30,"name":"Bob"}})");
+}
+
+TEST(JsonSerialize, Types) {
+    json_access_helper::serializer<tag::UserLangsT, tag::ScoresT, tag::RatioT, tag::ActiveT, tag::EscapedT> serializer;
+    auto text = serializer.write({"C++", "Rust"}, {{"a", 1}, {"b\t", 2}}, 2, false, "x");
+
+    EXPECT_EQ(text, R"({"a/b":{"\"q\"":"x"},"active":false,"ratio":2.0,)"
+                    R"("scores":{"a":1,"b\t":2},"user":{"languages":["C++","Rust"]}})");
+    auto jv = json::parse(text);
+    EXPECT_EQ(read(jv, tag::UserLangs), (vector<string>{"C++", "Rust"}));
+    EXPECT_EQ(read(jv, tag::Escaped),   "x");
+    EXPECT_EQ(read(jv, tag::Ratio),     2.0);
+    EXPECT_TRUE(jv.at("ratio").is_double());
+
+    EXPECT_EQ(serializer.write({}, {}, 0.25, true, string(1, '\x01')),
+              R"({"a/b":{"\"q\"":"\u0001"},"active":true,"ratio":0.25,"scores":{},"user":{"languages":[]}})");
+}
+
+TEST(JsonSerialize, Array) {
+    json_access_helper::serializer<tag::NewItemT, tag::Item1T, tag::NewItemT, tag::Item0T> serializer;
+    EXPECT_EQ(serializer.write("a", 1, "b", 0), R"({"items":[0,1,"a","b"]})");
+
+    json_access_helper::serializer<tag::RootT> root;
+    EXPECT_EQ(root.write("text"), R"("text")");
+}
+
+TEST(JsonSerialize, Buffer) {
+    json_access_helper::serializer<tag::IdT, tag::UserNameT> serializer;
+    const string expected = R"({"id":12,"user":{"name":"Alice"}})";
+
+    char buffer[64];
+    auto size = serializer.write(buffer, sizeof(buffer), 12, "Alice");
+    EXPECT_EQ(string(buffer, size), expected);
+
+    // returns the size of the whole text if the buffer is too small
+    EXPECT_EQ(serializer.write(buffer, 10, 12, "Alice"), expected.size());
+    EXPECT_EQ(serializer.write(nullptr, 0, 12, "Alice"), expected.size());
+}
+
+}  // namespace
@@ -0,0 +1,112 @@
+#include "json_access_helper.hpp"
+
+#include <cstdint>
+#include <numeric>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <boost/json.hpp>
+#include <gtest/gtest.h>
+
+#if !JSON_ACCESS_HELPER_ENABLE_STATS
+#error "json_helper_stats_test is built with JSON_ACCESS_HELPER_ENABLE_STATS=1"
+#endif
+
+namespace json = boost::json;
+using std::string;
+using std::vector;
+
+#define MAKE_JSON_ACCESSOR DECLARE_AND_DEFINE_JSON_ACCESSOR
+
+namespace json_stats_test_impl {
+
+MAKE_JSON_ACCESSOR(UserName,  string,         "/user/name")
+MAKE_JSON_ACCESSOR(UserAge,   int,            "/user/age")
+MAKE_JSON_ACCESSOR(UserLangs, vector<string>, "/user/languages")
+MAKE_JSON_ACCESSOR(Unused,    int,            "/unused")
+
+}  // namespace json_stats_test_impl
+
+namespace {
+
+using json_access_helper::accessor_stats;
+using json_access_helper::operation;
+
+namespace tag = json_stats_test_impl;
+
+std::uint64_t latency_total(const accessor_stats::counters& c) {
+    return std::accumulate(c.latency.begin(), c.latency.end(), std::uint64_t(0));
+}
+
+TEST(JsonStats, Counters) {
+    auto jv = json::parse(R"({"user": {"name": "Alice", "age": "23"}})");
+    accessor_stats::reset_all();
+    const auto& name = stats(tag::UserName);
+    const auto& age = stats(tag::UserAge);
+
+    EXPECT_EQ(read(jv, tag::UserName), "Alice");
+    EXPECT_TRUE(try_read(jv, tag::UserName));
+    EXPECT_TRUE(write(jv, tag::UserName, "Bob"));
+    emplace(jv, tag::UserName, "Carol");
+    EXPECT_TRUE(reference(jv, tag::UserName));
+
+    // a string is not converted to int
+    EXPECT_FALSE(try_read(jv, tag::UserAge));
+    EXPECT_ANY_THROW(read(jv, tag::UserAge));
+
+    auto c = name.get(operation::read);
+    EXPECT_EQ(c.calls,               2u);
+    EXPECT_EQ(c.misses,              0u);
+    EXPECT_EQ(c.conversion_failures, 0u);
+    EXPECT_EQ(latency_total(c),      2u);
+    EXPECT_EQ(name.get(operation::write).calls,     1u);
+    EXPECT_EQ(name.get(operation::emplace).calls,   1u);
+    EXPECT_EQ(name.get(operation::reference).calls, 1u);
+
+    c = age.get(operation::read);
+    EXPECT_EQ(c.calls,               2u);
+    EXPECT_EQ(c.misses,              0u);
+    EXPECT_EQ(c.conversion_failures, 2u);
+}
+
+TEST(JsonStats, Misses) {
+    auto jv = json::parse(R"({"user": 1})");
+    auto& langs = stats(tag::UserLangs);
+    langs.reset();
+
+    vector<string> out;
+    EXPECT_FALSE(try_read(jv, tag::UserLangs));
+    EXPECT_ANY_THROW(read(jv, tag::UserLangs));
+    EXPECT_TRUE(try_read_into(jv, tag::UserLangs, out));
+    EXPECT_FALSE(write(jv, tag::UserLangs, out));
+    EXPECT_FALSE(reference(jv, tag::UserLangs));
+    EXPECT_ANY_THROW(emplace(jv, tag::UserLangs, out));
+
+    auto c = langs.get(operation::read);
+    EXPECT_EQ(c.calls,               3u);
+    EXPECT_EQ(c.misses,              3u);
+    EXPECT_EQ(c.conversion_failures, 0u);
+    EXPECT_EQ(langs.get(operation::write).misses,     1u);
+    EXPECT_EQ(langs.get(operation::reference).misses, 1u);
+    EXPECT_EQ(langs.get(operation::emplace).misses,   1u);
+
+    langs.reset();
+    EXPECT_EQ(langs.get(operation::read).calls, 0u);
+}
+
+TEST(JsonStats, Enumerate) {
+    // the tags are listed even if they are never used
+    std::set<string> paths;
+    accessor_stats::for_each([&](const accessor_stats& s) { paths.emplace(s.path()); });
+    EXPECT_EQ(paths.count("/unused"), 1u);
+    EXPECT_EQ(paths.count("/user/name"), 1u);
+
+    auto unused = accessor_stats::find(path(tag::Unused));
+    ASSERT_TRUE(unused);
+    EXPECT_EQ(unused, &stats(tag::Unused));
+    EXPECT_EQ(unused->get(operation::read).calls, 0u);
+    EXPECT_FALSE(accessor_stats::find("/nothing"));
+}
+
+}  // namespace
@@ -1,5 +1,8 @@
 #include "json_access_helper.hpp"
 
+#include <iterator>
+#include <map>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -10,13 +13,34 @@ namespace json = boost::json;
 using std::string;
 using std::vector;
 
+using score_map = std::map<string, int>;
+
 #define MAKE_JSON_ACCESSOR DECLARE_AND_DEFINE_JSON_ACCESSOR
 
 namespace json_accessor_test_impl {
 
+// a type whose conversion to JSON always throws
+struct unconvertible {};
+
+void tag_invoke(json::value_from_tag, json::value&, const unconvertible&) {
+    throw std::runtime_error("unconvertible");
+}
+
+unconvertible tag_invoke(json::value_to_tag<unconvertible>, const json::value&) {
+    return {};
+}
+
 MAKE_JSON_ACCESSOR(UserName,  string,         "/user/name")
 MAKE_JSON_ACCESSOR(UserAge,   int,            "/user/age")
 MAKE_JSON_ACCESSOR(UserLangs, vector<string>, "/user/languages")
+MAKE_JSON_ACCESSOR(FirstLang, string,         "/user/languages/0")
+MAKE_JSON_ACCESSOR(LastLang,  string,         "/user/languages/-")
+MAKE_JSON_ACCESSOR(Escaped,   int,            "/a~1b/c~0d")
+MAKE_JSON_ACCESSOR(Scores,    score_map,      "/scores")
+MAKE_JSON_ACCESSOR(Extra,     json::value,    "/user/extra")
+MAKE_JSON_ACCESSOR(Deep,      unconvertible,  "/user/deep/0/x")
+MAKE_JSON_ACCESSOR(NewLang,   unconvertible,  "/user/languages/-")
+MAKE_JSON_ACCESSOR(BadIndex,  int,            "/user/deep/k/5")
 
 }  // namespace json_accessor_test_impl
 
@@ -33,6 +57,10 @@ const auto template_json = json::value {
 using json_accessor_test_impl::reference;
 using json_accessor_test_impl::read;
 using json_accessor_test_impl::try_read;
+using json_accessor_test_impl::read_view;
+using json_accessor_test_impl::try_read_view;
+using json_accessor_test_impl::read_into;
+using json_accessor_test_impl::try_read_into;
 using json_accessor_test_impl::write;
 using json_accessor_test_impl::emplace;
 using json_accessor_test_impl::path;
@@ -53,6 +81,33 @@ TEST(JsonAccessor, Read) {
     EXPECT_ANY_THROW(read(json_2, tag::UserLangs));
 }
 
+TEST(JsonAccessor, ReadMultiple) {
+    auto json_1 = template_json;
+    auto json_2 = json::value();
+
+    auto [name, age, langs, first] = read(json_1, tag::UserName, tag::UserAge, tag::UserLangs, tag::FirstLang);
+    EXPECT_EQ(name,  "Alice");
+    EXPECT_EQ(age,   23);
+    EXPECT_EQ(langs, (vector<string>{"C++", "Python", "Haskell", "Rust"}));
+    EXPECT_EQ(first, "C++");
+
+    // throws exception if any error occurs
+    EXPECT_ANY_THROW(read(json_1, tag::UserName, tag::Escaped));
+    EXPECT_ANY_THROW(read(json_2, tag::UserName, tag::UserAge));
+}
+
+TEST(JsonAccessor, TryReadMultiple) {
+    auto json_1 = template_json;
+
+    auto [name, escaped, last, age] = try_read(json_1, tag::UserName, tag::Escaped, tag::LastLang, tag::UserAge);
+    EXPECT_TRUE(name);
+    EXPECT_TRUE(age);
+    EXPECT_EQ(*name, "Alice");
+    EXPECT_EQ(*age,  23);
+    EXPECT_EQ(escaped.error(), try_read(json_1, tag::Escaped).error());
+    EXPECT_EQ(last.error(),    try_read(json_1, tag::LastLang).error());
+}
+
 TEST(JsonAccessor, TryRead) {
     auto json_1 = template_json;
     auto json_2 = json::value();
@@ -77,6 +132,76 @@ TEST(JsonAccessor, TryRead) {
     EXPECT_FALSE(lang_2);
 }
 
+TEST(JsonAccessor, ReadView) {
+    auto json_1 = template_json;
+    auto json_2 = json::value();
+
+    // refers to the strings in the document
+    std::string_view name = read_view(json_1, tag::UserName);
+    EXPECT_EQ(name, "Alice");
+    EXPECT_EQ(name.data(), json_1.at_pointer("/user/name").as_string().data());
+
+    // converts the elements on dereference
+    auto langs = read_view(json_1, tag::UserLangs);
+    EXPECT_EQ(langs.size(), 4u);
+    EXPECT_EQ(langs[2], "Haskell");
+    EXPECT_EQ(vector<string>(langs.begin(), langs.end()), read(json_1, tag::UserLangs));
+
+    // the other types are converted by value_to
+    int age = read_view(json_1, tag::UserAge);
+    EXPECT_EQ(age, 23);
+
+    // throws exception if any error occurs
+    EXPECT_ANY_THROW(read_view(json_2, tag::UserName));
+    EXPECT_ANY_THROW(read_view(json::value{{"user", {{"name", 1}}}}, tag::UserName));
+
+    EXPECT_TRUE(try_read_view(json_1, tag::UserLangs));
+    EXPECT_EQ(*try_read_view(json_1, tag::FirstLang), "C++");
+    EXPECT_EQ(try_read_view(json_2, tag::UserLangs).error(), try_read(json_2, tag::UserLangs).error());
+    EXPECT_EQ(try_read_view(json::value{{"user", {{"languages", 1}}}}, tag::UserLangs).error(),
+              json::error::not_array);
+}
+
+TEST(JsonAccessor, ReadInto) {
+    auto json_1 = template_json;
+    auto json_2 = json::value();
+
+    string name(64, 'x');
+    const auto name_data = name.data();
+    read_into(json_1, tag::UserName, name);
+    EXPECT_EQ(name, "Alice");
+    EXPECT_EQ(name.data(), name_data);
+
+    // the vector and its elements keep their storage
+    vector<string> langs(8, string(64, 'x'));
+    const auto langs_data = langs.data();
+    const auto lang_data = langs[0].data();
+    read_into(json_1, tag::UserLangs, langs);
+    EXPECT_EQ(langs, read(json_1, tag::UserLangs));
+    EXPECT_EQ(langs.data(), langs_data);
+    EXPECT_EQ(langs[0].data(), lang_data);
+
+    // the entries not in the object are removed
+    score_map scores = {{"a", 0}, {"stale", 0}};
+    const auto a_entry = &*scores.find("a");
+    read_into(json::value{{"scores", {{"a", 1}, {"b", 2}}}}, tag::Scores, scores);
+    EXPECT_EQ(scores, (score_map{{"a", 1}, {"b", 2}}));
+    EXPECT_EQ(&*scores.find("a"), a_entry);
+
+    // throws exception if any error occurs
+    EXPECT_ANY_THROW(read_into(json_2, tag::UserName, name));
+    EXPECT_ANY_THROW(read_into(json::value{{"scores", {{"a", "1"}}}}, tag::Scores, scores));
+
+    int age = 0;
+    EXPECT_FALSE(try_read_into(json_1, tag::UserAge, age));
+    EXPECT_EQ(age, 23);
+    EXPECT_EQ(try_read_into(json_2, tag::UserAge, age), try_read(json_2, tag::UserAge).error());
+    EXPECT_EQ(try_read_into(json::value{{"user", {{"name", 1}}}}, tag::UserName, name),
+              json::error::not_string);
+    EXPECT_EQ(try_read_into(json::value{{"user", {{"languages", {{"a", 1}}}}}}, tag::UserLangs, langs),
+              json::error::not_array);
+}
+
 TEST(JsonAccessor, Write) {
     auto json_1 = template_json;
     auto json_2 = json::value();
@@ -122,6 +247,54 @@ TEST(JsonAccessor, Write) {
     EXPECT_FALSE(lang_2_result_2);
 }
 
+TEST(JsonAccessor, WriteInPlace) {
+    json::monotonic_resource resource;
+    auto json_1 = json::value(template_json, json::storage_ptr(&resource));
+
+    // the existing string and array keep their buffers
+    const auto name_data  = json_1.at("user").at("name").as_string().data();
+    const auto langs_data = json_1.at("user").at("languages").as_array().data();
+    EXPECT_TRUE(write(json_1, tag::UserName,  string("Bob")));
+    EXPECT_TRUE(write(json_1, tag::UserLangs, vector<string>{"C", "Go"}));
+    EXPECT_EQ(json_1.at("user").at("name").as_string().data(),      name_data);
+    EXPECT_EQ(json_1.at("user").at("languages").as_array().data(), langs_data);
+    EXPECT_EQ(json_1.at("user").at("name"),      json::value("Bob"));
+    EXPECT_EQ(json_1.at("user").at("languages"), (json::array{"C", "Go"}));
+
+    // the new values are allocated with the storage of the document
+    EXPECT_TRUE(write(json_1, tag::UserAge, 24));
+    EXPECT_TRUE(write(json_1, tag::UserLangs, vector<string>{"C", "Go", "Rust"}));
+    EXPECT_EQ(json_1.at("user").at("languages").as_array()[2].storage(), json_1.storage());
+
+    // the members not in the map are removed
+    auto json_2 = json::value{{"scores", {{"a", 0}, {"stale", 0}}}};
+    EXPECT_TRUE(write(json_2, tag::Scores, score_map{{"a", 1}, {"b", 2}}));
+    EXPECT_EQ(json_2.at("scores"), (json::object{{"a", 1}, {"b", 2}}));
+
+    // the type of the existing value may change
+    auto json_3 = json::value{{"user", {{"name", 1}, {"languages", "C"}}}};
+    EXPECT_TRUE(write(json_3, tag::UserName,  string("Alice")));
+    EXPECT_TRUE(write(json_3, tag::UserLangs, vector<string>{"C"}));
+    EXPECT_EQ(json_3, (json::value{{"user", {{"name", "Alice"}, {"languages", json::array{"C"}}}}}));
+}
+
+TEST(JsonAccessor, WriteMoved) {
+    auto json_1 = template_json;
+    const string text(64, 'x');
+
+    // a value converted by value_from is moved, not copied
+    json::value extra_1(json::string_view(text.data(), text.size()));
+    const auto data_1 = extra_1.as_string().data();
+    emplace(json_1, tag::Extra, std::move(extra_1));
+    EXPECT_EQ(json_1.at("user").at("extra").as_string().data(), data_1);
+
+    json::value extra_2(json::string_view(text.data(), text.size()));
+    const auto data_2 = extra_2.as_string().data();
+    EXPECT_TRUE(write(json_1, tag::Extra, std::move(extra_2)));
+    EXPECT_EQ(json_1.at("user").at("extra").as_string().data(), data_2);
+    EXPECT_EQ(json_1.at("user").at("extra").as_string(), text.c_str());
+}
+
 TEST(JsonAccessor, Emplace) {
     auto json_1 = template_json;
     auto json_2 = json::value();
@@ -160,6 +333,73 @@ TEST(JsonAccessor, Emplace) {
     EXPECT_TRUE(json_3.at("user").at("languages").is_null());
 }
 
+TEST(JsonAccessor, EmplaceThrow) {
+    // the values created on the pointer are removed again if the conversion throws
+    auto json_1 = template_json;
+    EXPECT_THROW(emplace(json_1, tag::Deep,    tag::unconvertible()), std::runtime_error);
+    EXPECT_THROW(emplace(json_1, tag::NewLang, tag::unconvertible()), std::runtime_error);
+    EXPECT_EQ(json_1, template_json);
+
+    auto json_2 = json::value();
+    EXPECT_THROW(emplace(json_2, tag::Deep, tag::unconvertible()), std::runtime_error);
+    EXPECT_TRUE(json_2.is_null());
+
+    // or if the pointer does not match the document
+    EXPECT_THROW(emplace(json_1, tag::BadIndex, 1), boost::system::system_error);
+    EXPECT_EQ(json_1, template_json);
+
+    // a null value made an object on the pointer is null again
+    json_1.at("user").as_object()["deep"] = nullptr;
+    const auto json_3 = json_1;
+    EXPECT_THROW(emplace(json_1, tag::Deep, tag::unconvertible()), std::runtime_error);
+    EXPECT_EQ(json_1, json_3);
+}
+
+bool uses_storage(const json::value& jv, const json::storage_ptr& sp) {
+    if (jv.storage() != sp) {
+        return false;
+    }
+    if (auto str = jv.if_string()) {
+        return str->storage() == sp;
+    }
+    if (auto arr = jv.if_array()) {
+        for (const auto& element : *arr) {
+            if (!uses_storage(element, sp)) {
+                return false;
+            }
+        }
+        return arr->storage() == sp;
+    }
+    if (auto obj = jv.if_object()) {
+        for (const auto& member : *obj) {
+            if (!uses_storage(member.value(), sp)) {
+                return false;
+            }
+        }
+        return obj->storage() == sp;
+    }
+    return true;
+}
+
+TEST(JsonAccessor, EmplaceStorage) {
+    json::monotonic_resource resource;
+    auto json_1 = json::value(json::storage_ptr(&resource));
+
+    // the intermediate values and the values are allocated with the storage of the document
+    emplace(json_1, tag::UserName,  string("Alice"));
+    emplace(json_1, tag::UserLangs, vector<string>{"C++", "Python"});
+    emplace(json_1, tag::FirstLang, string("C"));
+    emplace(json_1, tag::LastLang,  string("Rust"));
+    emplace(json_1, tag::Scores,    score_map{{"a", 1}});
+    emplace(json_1, tag::Escaped,   1);
+    EXPECT_EQ(read(json_1, tag::UserLangs), (vector<string>{"C", "Python", "Rust"}));
+    EXPECT_TRUE(uses_storage(json_1, json_1.storage()));
+
+    write(json_1, tag::UserLangs, vector<string>{"Go"});
+    write(json_1, tag::Scores, score_map{{"b", 2}, {"c", 3}});
+    EXPECT_TRUE(uses_storage(json_1, json_1.storage()));
+}
+
 TEST(JsonAccessor, Reference) {
     auto json_1 = template_json;
     auto json_2 = json::value();
@@ -182,10 +422,133 @@ TEST(JsonAccessor, Reference) {
     EXPECT_EQ(lang_ref_2, nullptr);
 }
 
+TEST(JsonAccessor, TokenizedPointer) {
+    using json_access_helper::pointer_traits;
+    using json_access_helper::token_kind;
+
+    const auto& tokens = pointer_traits<tag::EscapedT>::tokens;
+    EXPECT_EQ(tokens.size(), 2u);
+    EXPECT_EQ(tokens[0].key, "a/b");
+    EXPECT_EQ(tokens[1].key, "c~d");
+
+    const auto& lang_tokens = pointer_traits<tag::FirstLangT>::tokens;
+    EXPECT_EQ(lang_tokens[2].kind, token_kind::index);
+    EXPECT_EQ(lang_tokens[2].index, 0u);
+    EXPECT_EQ(pointer_traits<tag::LastLangT>::tokens[2].kind, token_kind::past_the_end);
+
+    auto json_1 = template_json;
+    auto json_2 = json::value{{"a/b", {{"c~d", 42}}}};
+
+    EXPECT_EQ(read(json_1, tag::FirstLang), "C++");
+    EXPECT_EQ(read(json_2, tag::Escaped), 42);
+
+    // reports the same errors as boost::json::value::find_pointer
+    json::error_code ec;
+    json_1.find_pointer(path(tag::LastLang), ec);
+    EXPECT_EQ(try_read(json_1, tag::LastLang).error(), ec);
+    json_1.find_pointer(path(tag::Escaped), ec);
+    EXPECT_EQ(try_read(json_1, tag::Escaped).error(), ec);
+
+    // appends the element when the index is past the end
+    emplace(json_1, tag::LastLang, "Go");
+    EXPECT_EQ(json_1.at("user").at("languages").as_array().back(), json::value("Go"));
+}
+
+TEST(JsonAccessor, MemberLookup) {
+    using json_access_helper::detail::find_member;
+    using json_access_helper::detail::make_token;
+
+    // keys of every size up to 40 which differ from each other only in one byte
+    vector<string> keys;
+    for (std::size_t size = 0; size <= 40; ++size) {
+        keys.push_back(string(size, 'k'));
+        for (std::size_t i = 0; i < size; ++i) {
+            keys.push_back(string(size, 'k'));
+            keys.back()[i] = 'x';
+        }
+    }
+
+    for (std::size_t members : {std::size_t(1), std::size_t(18), keys.size()}) {
+        json::object obj;
+        for (std::size_t i = 0; i < members; ++i) {
+            obj[keys[i]] = static_cast<int>(i);
+        }
+        const auto& const_obj = obj;
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            const auto t = make_token(keys[i]);
+            auto it = find_member(obj, t);
+            if (i < members) {
+                ASSERT_NE(it, obj.end()) << keys[i];
+                EXPECT_EQ(it->value(), json::value(static_cast<int>(i)));
+            } else {
+                EXPECT_EQ(it, obj.end()) << keys[i];
+            }
+            EXPECT_EQ(find_member(const_obj, t), it);
+        }
+    }
+
+    // the keys of the same size as the token differ in the last bytes
+    auto jv = json::value{{"user", {{"nam", 1}, {"namf", 2}, {"name", "Alice"}}}};
+    EXPECT_EQ(read(jv, tag::UserName), "Alice");
+}
+
+TEST(JsonAccessor, TraversalOrder) {
+    using json_access_helper::detail::make_token;
+    using json_access_helper::detail::token_span;
+    using json_access_helper::detail::token_span_less;
+
+    // indices, "-" and keys under one parent are in a total order
+    const json_access_helper::token tokens[] = {
+        make_token("5"), make_token("-"), make_token("."), make_token("10"), make_token("a"),
+    };
+    const auto span = [&](std::size_t i) { return token_span{&tokens[i], 1}; };
+    for (std::size_t i = 0; i < std::size(tokens); ++i) {
+        EXPECT_FALSE(token_span_less(span(i), span(i)));
+        for (std::size_t j = 0; j < std::size(tokens); ++j) {
+            if (i != j) {
+                EXPECT_NE(token_span_less(span(i), span(j)), token_span_less(span(j), span(i)));
+            }
+            for (std::size_t k = 0; k < std::size(tokens); ++k) {
+                if (token_span_less(span(i), span(j)) && token_span_less(span(j), span(k))) {
+                    EXPECT_TRUE(token_span_less(span(i), span(k)));
+                }
+            }
+        }
+    }
+    EXPECT_TRUE(token_span_less(span(0), span(3)));
+    EXPECT_TRUE(token_span_less(span(3), span(1)));
+    EXPECT_TRUE(token_span_less(span(1), span(2)));
+    EXPECT_TRUE(token_span_less(span(2), span(4)));
+}
+
+TEST(JsonAccessor, InlineCache) {
+    using json_access_helper::inline_cache;
+
+    auto json_1 = template_json;
+    auto json_2 = json::value{{"user", {{"age", 24}, {"name", "Bob"}}}};
+    auto json_3 = json::value{{"user", {{"name", "Carol"}}}};
+    json::error_code ec;
+
+    // the second lookup hits the cached members
+    EXPECT_EQ(inline_cache<tag::UserAgeT>::find(json_1, ec), &json_1.at("user").at("age"));
+    EXPECT_EQ(inline_cache<tag::UserAgeT>::find(json_1, ec), &json_1.at("user").at("age"));
+
+    // falls back to the normal lookup if the key order differs
+    EXPECT_EQ(inline_cache<tag::UserAgeT>::find(json_2, ec), &json_2.at("user").at("age"));
+    EXPECT_EQ(inline_cache<tag::UserAgeT>::find(json_1, ec), &json_1.at("user").at("age"));
+
+    EXPECT_EQ(inline_cache<tag::UserAgeT>::find(json_3, ec), nullptr);
+    EXPECT_EQ(ec, json::error::not_found);
+
+    const auto& const_json = json_1;
+    EXPECT_EQ(inline_cache<tag::FirstLangT>::find(const_json, ec), &json_1.at("user").at("languages").at(0));
+}
+
 TEST(JsonAccessor, Path) {
     EXPECT_EQ(path(tag::UserName),  "/user/name");
     EXPECT_EQ(path(tag::UserAge),   "/user/age");
     EXPECT_EQ(path(tag::UserLangs), "/user/languages");
+    EXPECT_EQ(path(tag::Escaped),   "/a~1b/c~0d");
 }
 
 }  // namespace
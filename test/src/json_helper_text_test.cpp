@@ -0,0 +1,166 @@
+#include "json_access_helper_text.hpp"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <boost/json.hpp>
+#include <gtest/gtest.h>
+
+namespace json = boost::json;
+using std::string;
+using std::string_view;
+using std::vector;
+
+#define MAKE_JSON_ACCESSOR DECLARE_AND_DEFINE_JSON_ACCESSOR
+
+namespace json_text_test_impl {
+
+MAKE_JSON_ACCESSOR(UserName,  string,         "/user/name")
+MAKE_JSON_ACCESSOR(UserAge,   int,            "/user/age")
+MAKE_JSON_ACCESSOR(UserLangs, vector<string>, "/user/languages")
+MAKE_JSON_ACCESSOR(ThirdLang, string,         "/user/languages/2")
+MAKE_JSON_ACCESSOR(LastLang,  string,         "/user/languages/-")
+MAKE_JSON_ACCESSOR(Nickname,  string,         "/user/nickname")
+MAKE_JSON_ACCESSOR(Escaped,   int,            "/a~1b")
+MAKE_JSON_ACCESSOR(Count,     int,            "/n")
+MAKE_JSON_ACCESSOR(Size,      unsigned,       "/n")
+MAKE_JSON_ACCESSOR(Total,     std::int64_t,   "/n")
+MAKE_JSON_ACCESSOR(Ratio,     double,         "/n")
+MAKE_JSON_ACCESSOR(NameView,  string_view,    "/user/name")
+MAKE_JSON_ACCESSOR(LangsJson, json::value,    "/user/languages")
+
+}  // namespace json_text_test_impl
+
+namespace {
+
+const auto template_text = std::string(R"({
+    "id": 1,
+    "history": [{"a": [1, 2, {"b": "c}]"}]}, "x\"y", 3.5, null, true],
+    "a/b": 7,
+    "user": {
+        "name": "Alice",
+        "age": 23,
+        "languages": ["C++", "Python", "Haskell", "Rust"]
+    }
+})");
+
+using json_text_test_impl::read;
+using json_text_test_impl::try_read;
+
+namespace tag = json_text_test_impl;
+
+TEST(JsonText, Read) {
+    EXPECT_EQ(read(template_text, tag::UserName),  "Alice");
+    EXPECT_EQ(read(template_text, tag::UserAge),   23);
+    EXPECT_EQ(read(template_text, tag::UserLangs), (vector<string>{"C++", "Python", "Haskell", "Rust"}));
+    EXPECT_EQ(read(template_text, tag::ThirdLang), "Haskell");
+    EXPECT_EQ(read(template_text, tag::Escaped),   7);
+    EXPECT_EQ(read(R"({"a\/b": 8})", tag::Escaped), 8);
+
+    // same tags work on the parsed document
+    auto jv = json::parse(template_text);
+    EXPECT_EQ(read(jv, tag::UserAge), 23);
+
+    // throws exception if any error occurs
+    EXPECT_ANY_THROW(read(template_text, tag::Nickname));
+    EXPECT_ANY_THROW(read("{\"user\": ", tag::UserName));
+}
+
+TEST(JsonText, TryRead) {
+    auto name = try_read(template_text, tag::UserName);
+    EXPECT_TRUE(name);
+    EXPECT_EQ(*name, "Alice");
+
+    // reports the same errors as the accessors on the parsed document
+    auto jv = json::parse(template_text);
+    EXPECT_EQ(try_read(template_text, tag::Nickname).error(), try_read(jv, tag::Nickname).error());
+    EXPECT_EQ(try_read(template_text, tag::LastLang).error(), try_read(jv, tag::LastLang).error());
+    EXPECT_EQ(try_read("[]", tag::UserName).error(), try_read(json::value(json::array()), tag::UserName).error());
+    EXPECT_EQ(try_read("1", tag::UserName).error(),  try_read(json::value(1), tag::UserName).error());
+
+    EXPECT_EQ(try_read("{\"user\": {\"languages\": [1, 2]}}", tag::ThirdLang).error(), json::error::not_found);
+    EXPECT_FALSE(try_read("{\"user\": {\"age\": \"23\"}}", tag::UserAge));
+    EXPECT_FALSE(try_read("{\"user\" 1}", tag::UserAge));
+}
+
+TEST(JsonText, Number) {
+    // numbers are decoded according to the type of the tag
+    EXPECT_EQ(read(R"({"n": -12})", tag::Count), -12);
+    EXPECT_EQ(read(R"({"n": 9007199254740993})", tag::Total), 9007199254740993);
+    EXPECT_EQ(read(R"({"n": 0.125})", tag::Ratio), 0.125);
+    EXPECT_EQ(read(R"({"n": -12})", tag::Ratio), -12.0);
+    EXPECT_EQ(read(R"({"n": 25E-1 })", tag::Ratio), 2.5);
+
+    // the other numbers are converted as the accessors on the parsed document do
+    for (auto text : {R"({"n": 1e2})", R"({"n": 1.5})", R"({"n": 3000000000})", R"({"n": -0})",
+                      R"({"n": -1})", R"({"n": "1"})", R"({"n": true})", R"({"n": 01})"}) {
+        json::error_code ec;
+        auto jv = json::parse(text, ec);
+        EXPECT_EQ(try_read(text, tag::Count).has_value(), !jv.is_null() && try_read(jv, tag::Count).has_value()) << text;
+        EXPECT_EQ(try_read(text, tag::Size).has_value(),  !jv.is_null() && try_read(jv, tag::Size).has_value()) << text;
+        if (!jv.is_null() && try_read(jv, tag::Count)) {
+            EXPECT_EQ(read(text, tag::Count), read(jv, tag::Count)) << text;
+        }
+    }
+}
+
+TEST(JsonText, StringView) {
+    // refers to the string in the text
+    auto name = read(template_text, tag::NameView);
+    EXPECT_EQ(name, "Alice");
+    EXPECT_TRUE(name.data() > template_text.data() && name.data() < template_text.data() + template_text.size());
+    const auto index = json_access_helper::structural_index(template_text);
+    EXPECT_EQ(read(index, tag::NameView).data(), name.data());
+
+    // a string with escapes cannot be referred to
+    EXPECT_EQ(try_read(R"({"user": {"name": "A\u006cice"}})", tag::NameView).error(), json::error::not_exact);
+    EXPECT_EQ(try_read(R"({"user": {"name": "A\""}})", tag::NameView).error(), json::error::not_exact);
+    EXPECT_FALSE(try_read(R"({"user": {"name": 1}})", tag::NameView));
+
+    // a Boost.JSON value is copied off the buffer of the reader
+    auto langs = read(template_text, tag::LangsJson);
+    EXPECT_EQ(langs, json::parse(R"(["C++", "Python", "Haskell", "Rust"])"));
+    EXPECT_EQ(langs.storage().get(), json::storage_ptr().get());
+}
+
+TEST(JsonText, StructuralIndex) {
+    using json_access_helper::simd_level;
+    using json_access_helper::structural_index;
+
+    // moves the escapes and the strings over every position of the 64-byte blocks
+    for (std::size_t pad = 0; pad < 130; ++pad) {
+        auto text = "{\"pad\": \"" + string(pad, '.') + R"(", "s": "\\\"}],:\\", "h": ["[", {"k": "\"{"}],)"
+                  + template_text.substr(1);
+        const auto index = structural_index(text, simd_level::scalar);
+
+        // the index gives the same results as the scanning
+        EXPECT_EQ(read(index, tag::UserName), "Alice");
+        EXPECT_EQ(read(index, tag::UserLangs), read(text, tag::UserLangs));
+        EXPECT_EQ(read(index, tag::ThirdLang), "Haskell");
+        EXPECT_EQ(read(index, tag::Escaped), 7);
+        EXPECT_EQ(try_read(index, tag::Nickname).error(), try_read(text, tag::Nickname).error());
+        EXPECT_EQ(try_read(index, tag::LastLang).error(), try_read(text, tag::LastLang).error());
+
+        // every supported instruction set builds the same index
+        for (auto level : {simd_level::sse2, simd_level::avx2}) {
+            if (level > json_access_helper::supported_simd_level()) {
+                continue;
+            }
+            const auto simd_index = structural_index(text, level);
+            for (std::size_t pos = 0; pos <= text.size(); ++pos) {
+                ASSERT_EQ(simd_index.next(pos), index.next(pos));
+            }
+            EXPECT_EQ(read(simd_index, tag::UserLangs), read(index, tag::UserLangs));
+        }
+    }
+
+    EXPECT_EQ(read(structural_index(R"({"a\/b": 8})"), tag::Escaped), 8);
+    EXPECT_EQ(read(structural_index(R"({"user": {"age": 23}})"), tag::UserAge), 23);
+    EXPECT_FALSE(try_read(structural_index("{\"user\": "), tag::UserName));
+    EXPECT_FALSE(try_read(structural_index("{\"user\": {\"name\": \"Al"), tag::UserName));
+    EXPECT_EQ(try_read(structural_index("[]"), tag::UserName).error(), json::error::token_not_number);
+}
+
+}  // namespace
@@ -0,0 +1,146 @@
+#include "json_access_helper_tracked.hpp"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <boost/json.hpp>
+#include <gtest/gtest.h>
+
+namespace json = boost::json;
+using std::string;
+using std::vector;
+
+#define MAKE_JSON_ACCESSOR DECLARE_AND_DEFINE_JSON_ACCESSOR
+
+namespace json_tracked_test_impl {
+
+MAKE_JSON_ACCESSOR(UserName,  string,         "/user/name")
+MAKE_JSON_ACCESSOR(UserAge,   int,            "/user/age")
+MAKE_JSON_ACCESSOR(UserLangs, vector<string>, "/user/languages")
+MAKE_JSON_ACCESSOR(FirstLang, string,         "/user/languages/0")
+MAKE_JSON_ACCESSOR(NewLang,   string,         "/user/languages/-")
+MAKE_JSON_ACCESSOR(Theme,     string,         "/settings/ui/theme")
+MAKE_JSON_ACCESSOR(Nickname,  string,         "/user/nickname")
+MAKE_JSON_ACCESSOR(History,   string,         "/history")
+MAKE_JSON_ACCESSOR(BadIndex,  int,            "/n/k/5")
+
+}  // namespace json_tracked_test_impl
+
+namespace {
+
+const auto template_json = json::parse(R"({
+    "id": 1,
+    "user": {
+        "name": "Alice",
+        "age": 23,
+        "languages": ["C++", "Python"]
+    },
+    "history": [{"a": [1, 2, {"b": "c"}]}, "x\"y", 3.5, null, true]
+})");
+
+namespace tag = json_tracked_test_impl;
+
+// the segment which contains the text
+std::string_view find_segment(const vector<std::string_view>& segments, std::string_view text) {
+    for (auto segment : segments) {
+        if (segment.find(text) != std::string_view::npos) {
+            return segment;
+        }
+    }
+    return {};
+}
+
+TEST(JsonTracked, Write) {
+    json_access_helper::tracked_document doc(template_json);
+    EXPECT_EQ(doc.serialize(), json::serialize(template_json));
+
+    EXPECT_TRUE(write(doc, tag::UserName, "Bob"));
+    EXPECT_FALSE(write(doc, tag::Nickname, "B"));
+    EXPECT_EQ(read(doc.value(), tag::UserName), "Bob");
+    EXPECT_EQ(doc.serialize(), json::serialize(doc.value()));
+
+    // the text of the clean subtrees is kept
+    const auto history = find_segment(doc.serialize_segments(), "x\\\"y");
+    EXPECT_TRUE(write(doc, tag::UserAge, 24));
+    EXPECT_TRUE(write(doc, tag::FirstLang, "Rust"));
+    EXPECT_EQ(doc.serialize(), json::serialize(doc.value()));
+    const auto& segments = doc.serialize_segments();
+    EXPECT_EQ(find_segment(segments, "x\\\"y").data(), history.data());
+    EXPECT_EQ(find_segment(segments, "Python"), "\"Python\"");
+}
+
+TEST(JsonTracked, ExpandText) {
+    auto jv = template_json;
+    jv.as_object()["k\"]},{"] = json::parse(R"({"s": "]},[\\", "e": [], "o": {}})");
+    json_access_helper::tracked_document doc(jv);
+    const auto text = doc.serialize_segments().front();
+    const auto within_text = [&](std::string_view segment) {
+        return text.data() <= segment.data() && segment.data() + segment.size() <= text.data() + text.size();
+    };
+
+    // the members are parts of the text serialized before, not serialized again
+    EXPECT_TRUE(write(doc, tag::UserAge, 24));
+    emplace(doc, tag::Theme, "dark");
+    EXPECT_EQ(doc.serialize(), json::serialize(doc.value()));
+    const auto& segments = doc.serialize_segments();
+    EXPECT_TRUE(within_text(find_segment(segments, "x\\\"y")));
+    EXPECT_TRUE(within_text(find_segment(segments, "Python")));
+    EXPECT_TRUE(within_text(find_segment(segments, "]},[")));
+    EXPECT_FALSE(within_text(find_segment(segments, "dark")));
+}
+
+TEST(JsonTracked, Emplace) {
+    json_access_helper::tracked_document doc(template_json);
+    doc.serialize();
+
+    emplace(doc, tag::Theme, "dark");
+    emplace(doc, tag::Nickname, "A");
+    emplace(doc, tag::NewLang, "Go");
+    EXPECT_EQ(doc.serialize(), json::serialize(doc.value()));
+
+    emplace(doc, tag::UserLangs, {"Haskell"});
+    emplace(doc, tag::History, "none");
+    EXPECT_EQ(doc.serialize(), json::serialize(doc.value()));
+
+    json_access_helper::tracked_document empty;
+    emplace(empty, tag::UserName, "Carol");
+    EXPECT_EQ(empty.serialize(), R"({"user":{"name":"Carol"}})");
+
+    // the objects and arrays created before the error are removed again
+    json_access_helper::tracked_document failed(template_json);
+    failed.serialize();
+    EXPECT_THROW(emplace(failed, tag::BadIndex, 1), boost::system::system_error);
+    EXPECT_EQ(failed.value(), template_json);
+    EXPECT_EQ(failed.serialize(), json::serialize(failed.value()));
+}
+
+TEST(JsonTracked, Modify) {
+    json_access_helper::tracked_document doc(template_json);
+    doc.serialize();
+
+    auto age = reference(doc, tag::UserAge);
+    *age = 30;
+    EXPECT_EQ(doc.serialize(), json::serialize(doc.value()));
+
+    // a change after the serialization is not seen unless it is marked again
+    *age = 31;
+    EXPECT_NE(doc.serialize(), json::serialize(doc.value()));
+    EXPECT_EQ(read(json::parse(doc.serialize()), tag::UserAge), 30);
+    doc.mark_dirty(tag::UserAge);
+    EXPECT_EQ(doc.serialize(), json::serialize(doc.value()));
+    EXPECT_EQ(read(doc.value(), tag::UserAge), 31);
+
+    // "-" of an empty array marks nothing but the containers on the pointer
+    doc.modify().as_object()["user"].as_object()["languages"].as_array().clear();
+    doc.serialize();
+    doc.mark_dirty(tag::NewLang);
+    EXPECT_EQ(doc.serialize(), json::serialize(doc.value()));
+
+    doc.modify().as_object()["id"] = 2;
+    EXPECT_EQ(doc.serialize(), json::serialize(doc.value()));
+    EXPECT_TRUE(write(doc, tag::UserName, "Eve"));
+    EXPECT_EQ(doc.serialize(), json::serialize(doc.value()));
+}
+
+}  // namespace
@@ -0,0 +1,122 @@
+#include "json_access_helper_wildcard.hpp"
+
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/json.hpp>
+#include <gtest/gtest.h>
+
+namespace json = boost::json;
+using std::string;
+using std::vector;
+
+namespace json_wildcard_test_impl {
+
+DEFINE_JSON_WILDCARD_ACCESSOR(UserAges,   int,    "/users/*/age")
+DEFINE_JSON_WILDCARD_ACCESSOR(UserNames,  string, "/users/*/name")
+DEFINE_JSON_WILDCARD_ACCESSOR(UserLangs,  string, "/users/*/languages/*")
+DEFINE_JSON_WILDCARD_ACCESSOR(GroupSizes, int,    "/groups/*/size")
+DEFINE_JSON_WILDCARD_ACCESSOR(Values,     int,    "/values/*")
+DEFINE_JSON_WILDCARD_ACCESSOR(Flags,      bool,   "/flags/*")
+
+}  // namespace json_wildcard_test_impl
+
+namespace {
+
+const auto template_json = json::parse(R"({
+    "users": [
+        {"name": "Alice", "age": 23, "languages": ["C++", "Python"]},
+        {"name": "Bob", "age": 31, "languages": []},
+        {"name": "Carol", "age": 40, "languages": ["Rust"]}
+    ],
+    "groups": {"dev": {"size": 3}, "qa": {"size": 1}},
+    "members": [{"name": "Dave"}]
+})");
+
+namespace tag = json_wildcard_test_impl;
+
+TEST(JsonWildcard, Read) {
+    const auto& jv = template_json;
+    EXPECT_EQ(read(jv, tag::UserAges),   (vector<int>{23, 31, 40}));
+    EXPECT_EQ(read(jv, tag::UserNames),  (vector<string>{"Alice", "Bob", "Carol"}));
+    EXPECT_EQ(read(jv, tag::UserLangs),  (vector<string>{"C++", "Python", "Rust"}));
+    EXPECT_EQ(read(jv, tag::GroupSizes), (vector<int>{3, 1}));
+
+    // the capacity is reused
+    vector<int> ages;
+    ages.reserve(16);
+    read_into(jv, tag::UserAges, ages);
+    EXPECT_EQ(ages, (vector<int>{23, 31, 40}));
+    EXPECT_EQ(ages.capacity(), 16u);
+}
+
+TEST(JsonWildcard, Error) {
+    auto jv = template_json;
+    EXPECT_EQ(try_read(jv, tag::Values).error(), json::error::not_found);
+    EXPECT_ANY_THROW(read(jv, tag::Values));
+
+    jv.at("users").as_array()[1].as_object().erase("age");
+    EXPECT_EQ(try_read(jv, tag::UserAges).error(), json::error::not_found);
+
+    jv.at("users").as_array()[1].as_object()["age"] = "31";
+    EXPECT_FALSE(try_read(jv, tag::UserAges));
+
+    jv.as_object()["values"] = 1;
+    EXPECT_EQ(try_read(jv, tag::Values).error(), json::error::value_is_scalar);
+    jv.as_object()["values"] = json::array();
+    EXPECT_TRUE(try_read(jv, tag::Values)->empty());
+}
+
+TEST(JsonWildcard, Parallel) {
+    json::value jv = json::object();
+    auto& values = jv.as_object()["values"].emplace_array();
+    auto& users = jv.as_object()["users"].emplace_array();
+    auto& flags = jv.as_object()["flags"].emplace_array();
+    vector<int> expected;
+    vector<string> expected_langs;
+    for (int i = 0; i < 10000; ++i) {
+        values.emplace_back(static_cast<std::int64_t>(i));
+        expected.push_back(i);
+        flags.emplace_back(i % 3 == 0);
+
+        json::array langs;
+        for (int j = 0; j < i % 3; ++j) {
+            langs.emplace_back(std::to_string(i));
+            expected_langs.push_back(std::to_string(i));
+        }
+        json::object user;
+        user["languages"] = std::move(langs);
+        users.emplace_back(std::move(user));
+    }
+
+    const json_access_helper::parallel_policy policy{4, 100};
+    EXPECT_EQ(read(policy, jv, tag::Values),    expected);
+    EXPECT_EQ(read(policy, jv, tag::UserLangs), expected_langs);
+    EXPECT_EQ(read(policy, jv, tag::Flags),     read(jv, tag::Flags));
+    EXPECT_EQ(read(json_access_helper::parallel, jv, tag::Values), expected);
+
+    values[7777] = "x";
+    EXPECT_FALSE(try_read(policy, jv, tag::Values));
+    values[7777] = 7777;
+
+    // the pool is kept between reads, and a read made while it is busy runs on its own thread
+    std::vector<std::thread> readers;
+    std::vector<vector<int>> results(4);
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        readers.emplace_back([&, i] {
+            for (int k = 0; k < 10; ++k) {
+                results[i] = read(policy, jv, tag::Values);
+            }
+        });
+    }
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    for (const auto& result : results) {
+        EXPECT_EQ(result, expected);
+    }
+}
+
+}  // namespace